@@ -0,0 +1,237 @@
+#include "turboply.hpp"
+#include <array>
+#include <algorithm>
+#include <limits>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TURBOPLY_SSE2 1
+#include <immintrin.h>
+#endif
+
+namespace turboply {
+
+using detail::ColumnCopyFn;
+
+namespace {
+
+    template <typename S, typename D, bool Saturate>
+    D convertValue(S v) {
+        using Limits = std::numeric_limits<D>;
+
+        if constexpr (Saturate && std::is_floating_point_v<S> && std::is_floating_point_v<D> && sizeof(S) > sizeof(D)) {
+            // NaN保持为NaN
+            if (v < -static_cast<S>(Limits::max())) return -Limits::max();
+            if (v > static_cast<S>(Limits::max())) return Limits::max();
+            return static_cast<D>(v);
+        }
+        else if constexpr (!Saturate || std::is_floating_point_v<D> || std::is_same_v<S, D>) {
+            return static_cast<D>(v);
+        }
+        else if constexpr (std::is_floating_point_v<S>) {
+            if (v != v) return D{};
+            if (v <= static_cast<S>(Limits::min())) return Limits::min();
+            if (v >= static_cast<S>(Limits::max())) return Limits::max();
+            return static_cast<D>(v);
+        }
+        else {
+            if (std::cmp_less(v, Limits::min())) return Limits::min();
+            if (std::cmp_greater(v, Limits::max())) return Limits::max();
+            return static_cast<D>(v);
+        }
+    }
+
+    // 连续存储的批量转换, 返回已处理的个数, 其余由标量循环完成
+    template <typename S, typename D, bool Saturate>
+    size_t convertPacked(const std::byte* src, std::byte* dst, size_t n) {
+        size_t i = 0;
+
+#if TURBOPLY_SSE2
+        const __m128i zero = _mm_setzero_si128();
+
+        if constexpr (std::is_same_v<S, uint8_t> && std::is_same_v<D, float>) {
+#if defined(__AVX2__)
+            for (; i + 8 <= n; i += 8) {
+                __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+                _mm256_storeu_ps(reinterpret_cast<float*>(dst) + i, _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v)));
+            }
+#endif
+            for (; i + 16 <= n; i += 16) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                __m128i lo = _mm_unpacklo_epi8(v, zero), hi = _mm_unpackhi_epi8(v, zero);
+                float* out = reinterpret_cast<float*>(dst) + i;
+                _mm_storeu_ps(out + 0, _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)));
+                _mm_storeu_ps(out + 4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)));
+                _mm_storeu_ps(out + 8, _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)));
+                _mm_storeu_ps(out + 12, _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)));
+            }
+        }
+        else if constexpr (std::is_same_v<S, uint16_t> && std::is_same_v<D, float>) {
+            for (; i + 8 <= n; i += 8) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + i / 8);
+                float* out = reinterpret_cast<float*>(dst) + i;
+                _mm_storeu_ps(out + 0, _mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero)));
+                _mm_storeu_ps(out + 4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero)));
+            }
+        }
+        else if constexpr (std::is_same_v<S, int32_t> && std::is_same_v<D, float>) {
+            for (; i + 4 <= n; i += 4) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + i / 4);
+                _mm_storeu_ps(reinterpret_cast<float*>(dst) + i, _mm_cvtepi32_ps(v));
+            }
+        }
+        else if constexpr (std::is_same_v<S, double> && std::is_same_v<D, float>) {
+            // 饱和时先限制到float的有限范围; min/max的NaN操作数放在第二位, 使NaN保持不变
+            constexpr double MAX = std::numeric_limits<float>::max();
+#if defined(__AVX__)
+            const __m256d hi4 = _mm256_set1_pd(MAX), lo4 = _mm256_set1_pd(-MAX);
+            for (; i + 4 <= n; i += 4) {
+                __m256d v = _mm256_loadu_pd(reinterpret_cast<const double*>(src) + i);
+                if constexpr (Saturate) v = _mm256_max_pd(lo4, _mm256_min_pd(hi4, v));
+                _mm_storeu_ps(reinterpret_cast<float*>(dst) + i, _mm256_cvtpd_ps(v));
+            }
+#endif
+            const __m128d hi2 = _mm_set1_pd(MAX), lo2 = _mm_set1_pd(-MAX);
+            for (; i + 4 <= n; i += 4) {
+                __m128d a = _mm_loadu_pd(reinterpret_cast<const double*>(src) + i);
+                __m128d b = _mm_loadu_pd(reinterpret_cast<const double*>(src) + i + 2);
+                if constexpr (Saturate) {
+                    a = _mm_max_pd(lo2, _mm_min_pd(hi2, a));
+                    b = _mm_max_pd(lo2, _mm_min_pd(hi2, b));
+                }
+                _mm_storeu_ps(reinterpret_cast<float*>(dst) + i, _mm_movelh_ps(_mm_cvtpd_ps(a), _mm_cvtpd_ps(b)));
+            }
+        }
+        else if constexpr (std::is_same_v<S, float> && std::is_same_v<D, double>) {
+#if defined(__AVX__)
+            for (; i + 4 <= n; i += 4)
+                _mm256_storeu_pd(reinterpret_cast<double*>(dst) + i, _mm256_cvtps_pd(_mm_loadu_ps(reinterpret_cast<const float*>(src) + i)));
+#endif
+            for (; i + 4 <= n; i += 4) {
+                __m128 v = _mm_loadu_ps(reinterpret_cast<const float*>(src) + i);
+                _mm_storeu_pd(reinterpret_cast<double*>(dst) + i, _mm_cvtps_pd(v));
+                _mm_storeu_pd(reinterpret_cast<double*>(dst) + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+            }
+        }
+        else if constexpr (std::is_same_v<S, float> && std::is_same_v<D, uint8_t> && Saturate) {
+            // 先钳位到[0, 255] (max_ps遇NaN返回第二个操作数, 即0), 再截断取整并压缩
+            const __m128 lo = _mm_setzero_ps(), hi = _mm_set1_ps(255.0f);
+            auto clamp = [&](const float* in) { return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(in), lo), hi)); };
+            for (; i + 16 <= n; i += 16) {
+                const float* in = reinterpret_cast<const float*>(src) + i;
+                __m128i a = clamp(in + 0), b = clamp(in + 4), c = clamp(in + 8), d = clamp(in + 12);
+                __m128i v = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+            }
+        }
+#endif
+
+        return i;
+    }
+
+    // convertPacked是否有批量路径 (与其中的分支一致)
+    template <typename S, typename D, bool Saturate>
+    constexpr bool hasPackedKernel() {
+#if TURBOPLY_SSE2
+        return (std::is_same_v<D, float> && (std::is_same_v<S, uint8_t> || std::is_same_v<S, uint16_t> || std::is_same_v<S, int32_t> || std::is_same_v<S, double>))
+            || (std::is_same_v<S, float> && std::is_same_v<D, double>)
+            || (std::is_same_v<S, float> && std::is_same_v<D, uint8_t> && Saturate);
+#else
+        return false;
+#endif
+    }
+
+    template <typename S, typename D, bool Saturate>
+    void convertColumn(const std::byte* src, size_t src_stride, std::byte* dst, size_t dst_stride, size_t count) {
+        constexpr size_t BLOCK = 256;
+        constexpr size_t MIN_BLOCK = 16;
+
+        size_t i = 0;
+        if (src_stride == sizeof(S) && dst_stride == sizeof(D)) {
+            i = convertPacked<S, D, Saturate>(src, dst, count);
+        }
+        else if constexpr (hasPackedKernel<S, D, Saturate>()) {
+            // 定长行中的列: 逐块收集为连续的值后批量转换, 目标不连续时再按跨度写回
+            S values[BLOCK];
+            D results[BLOCK];
+            for (; count - i >= MIN_BLOCK; ) {
+                const size_t n = std::min(BLOCK, count - i);
+                for (size_t k = 0; k < n; ++k)
+                    std::memcpy(&values[k], src + (i + k) * src_stride, sizeof(S));
+
+                const bool packed_dst = dst_stride == sizeof(D);
+                std::byte* out = packed_dst ? dst + i * sizeof(D) : reinterpret_cast<std::byte*>(results);
+                for (size_t k = convertPacked<S, D, Saturate>(reinterpret_cast<const std::byte*>(values), out, n); k < n; ++k) {
+                    const D d = convertValue<S, D, Saturate>(values[k]);
+                    std::memcpy(out + k * sizeof(D), &d, sizeof(D));
+                }
+
+                if (!packed_dst) {
+                    for (size_t k = 0; k < n; ++k)
+                        std::memcpy(dst + (i + k) * dst_stride, &results[k], sizeof(D));
+                }
+                i += n;
+            }
+        }
+
+        for (; i < count; ++i) {
+            S v;
+            std::memcpy(&v, src + i * src_stride, sizeof(S));
+            const D d = convertValue<S, D, Saturate>(v);
+            std::memcpy(dst + i * dst_stride, &d, sizeof(D));
+        }
+    }
+
+    // 同宽整数 (int <-> uint) 及同类型在非饱和模式下按位拷贝
+    template <size_t Size>
+    void copyColumn(const std::byte* src, size_t src_stride, std::byte* dst, size_t dst_stride, size_t count) {
+        if (src_stride == Size && dst_stride == Size) {
+            std::memcpy(dst, src, Size * count);
+            return;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+            std::memcpy(dst + i * dst_stride, src + i * src_stride, Size);
+    }
+
+    constexpr size_t KIND_NUM = 9;
+    using KernelTable = std::array<std::array<std::array<ColumnCopyFn, 2>, KIND_NUM>, KIND_NUM>;
+
+    KernelTable makeKernelTable() {
+        KernelTable table{};
+
+        for (size_t s = 1; s < KIND_NUM; ++s) {
+            for (size_t d = 1; d < KIND_NUM; ++d) {
+                detail::visit_scalar_kind(static_cast<ScalarKind>(s), [&]<typename S>() {
+                    detail::visit_scalar_kind(static_cast<ScalarKind>(d), [&]<typename D>() {
+                        if constexpr (sizeof(S) == sizeof(D) && std::is_integral_v<S> == std::is_integral_v<D>) {
+                            table[s][d][0] = &copyColumn<sizeof(S)>;
+                            table[s][d][1] = std::is_same_v<S, D> ? &copyColumn<sizeof(S)> : &convertColumn<S, D, true>;
+                        }
+                        else {
+                            table[s][d][0] = &convertColumn<S, D, false>;
+                            table[s][d][1] = &convertColumn<S, D, true>;
+                        }
+                    });
+                });
+            }
+        }
+
+        return table;
+    }
+
+}
+
+ColumnCopyFn detail::convertKernel(ScalarKind src, ScalarKind dst, bool saturate) {
+    static const KernelTable table = makeKernelTable();
+
+    auto fn = table[static_cast<size_t>(src)][static_cast<size_t>(dst)][saturate ? 1 : 0];
+    if (!fn)
+        throw std::runtime_error("Ply Error: Unsupported scalar kind.");
+
+    return fn;
+}
+
+}
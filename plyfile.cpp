@@ -1,4 +1,22 @@
 #include "turboply.hpp"
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define TURBOPLY_POSIX_IO 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <sys/mman.h>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define TURBOPLY_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
 
 #if TURBOPLY_ENABLE_FILE_MAPPING
 #include <boost/interprocess/file_mapping.hpp>
@@ -6,7 +24,7 @@
 
 namespace {
 
-    class mapped_file_buf : public std::streambuf {
+    class mapped_file_buf : public turboply::detail::MemoryStreamBuf {
         boost::interprocess::file_mapping fm_;
         boost::interprocess::mapped_region region_;
         std::filesystem::path filename_;
@@ -42,35 +60,777 @@ namespace {
                 std::filesystem::resize_file(filename_, final_len);
             }
         }
+    };
+
+}
+
+#endif
 
+namespace {
+
+    // 按块读取的文件流缓冲: 块按文件顺序由派生类填充 (预读线程, io_uring), 解码端依次取用
+    // 定位到当前块之外时从对齐的偏移重新开始填充
+    class block_file_buf : public std::streambuf {
     protected:
+        static constexpr size_t ALIGNMENT = 4096;
+
+        struct Block {
+            char* data = nullptr;
+            size_t size = 0;        // 小于块大小即文件结束
+            off_type offset = 0;
+            int error = 0;          // 读取失败时的errno, 由underflow抛出而不当作文件结束
+        };
+
+        block_file_buf(const std::filesystem::path& filename, size_t block_size, size_t block_num)
+            : file_size_{ static_cast<off_type>(std::filesystem::file_size(filename)) } {
+            // 小文件只分配所需的大小
+            block_size_ = std::min(block_size, (static_cast<size_t>(file_size_) / ALIGNMENT + 1) * ALIGNMENT);
+            storage_ = std::make_unique<char[]>(block_size_ * block_num + ALIGNMENT);
+
+            char* base = storage_.get() + (ALIGNMENT - reinterpret_cast<uintptr_t>(storage_.get()) % ALIGNMENT) % ALIGNMENT;
+            ring_.resize(block_num);
+            for (size_t i = 0; i < block_num; ++i)
+                ring_[i].data = base + i * block_size_;
+        }
+
+        // 等待第seq块 (自本轮起始偏移计) 填充完成
+        virtual const Block& acquire(size_t seq) = 0;
+        // 第seq块已读完, 可以重新填充
+        virtual void release(size_t seq) = 0;
+        // 停止当前的填充, 从offset (ALIGNMENT的倍数) 起重新填充
+        virtual void restart(off_type offset) = 0;
+
+        virtual int_type underflow() override {
+            if (gptr() < egptr())
+                return traits_type::to_int_type(*gptr());
+
+            if (current_) {
+                if (current_->size < block_size_)
+                    return traits_type::eof();
+
+                release(seq_++);
+                current_ = nullptr;
+            }
+
+            current_ = &acquire(seq_);
+            if (current_->error)
+                throw std::runtime_error(std::format("Ply Error: Failed to read file at offset {}: {}.", current_->offset, std::strerror(current_->error)));
+
+            const size_t skip = std::min(skip_, current_->size);
+            skip_ = 0;
+
+            setg(current_->data, current_->data + skip, current_->data + current_->size);
+            return gptr() < egptr() ? traits_type::to_int_type(*gptr()) : traits_type::eof();
+        }
+
         virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
             std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override {
-            if (which & std::ios_base::out) {
-                char* target = nullptr;
-                if (dir == std::ios_base::beg)      target = pbase() + off;
-                else if (dir == std::ios_base::cur) target = pptr() + off;
-                else if (dir == std::ios_base::end) target = epptr() + off;
-
-                if (target >= pbase() && target <= epptr()) {
-                    setp(pbase(), epptr()); 
-                    pbump(static_cast<int>(target - pptr())); 
-                    return target - pbase();
+            if (!(which & std::ios_base::in))
+                return pos_type(off_type(-1));
+
+            const off_type pos = current_ ? current_->offset + (gptr() - eback()) : start_ + static_cast<off_type>(skip_);
+
+            off_type target = off;
+            if (dir == std::ios_base::cur)      target += pos;
+            else if (dir == std::ios_base::end) target += file_size_;
+            if (target < 0 || target > file_size_)
+                return pos_type(off_type(-1));
+
+            if (target == pos)
+                return target;
+            if (current_ && target >= current_->offset && target <= current_->offset + static_cast<off_type>(current_->size)) {
+                setg(eback(), eback() + (target - current_->offset), egptr());
+                return target;
+            }
+
+            current_ = nullptr;
+            setg(nullptr, nullptr, nullptr);
+
+            start_ = target - target % ALIGNMENT;
+            skip_ = static_cast<size_t>(target - start_);
+            seq_ = 0;
+            restart(start_);
+            return target;
+        }
+
+        virtual pos_type seekpos(pos_type sp,
+            std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override {
+            return seekoff(off_type(sp), std::ios_base::beg, which);
+        }
+
+        off_type file_size_;
+        size_t block_size_;
+        std::vector<Block> ring_;
+
+    private:
+        std::unique_ptr<char[]> storage_;
+        const Block* current_ = nullptr;
+        size_t seq_ = 0;
+        off_type start_ = 0;
+        size_t skip_ = 0;           // 首块中位于目标位置之前的字节
+    };
+
+    // 非映射读取的流水线: I/O线程把文件按大块预读进环形缓冲, 解码线程经无锁SPSC队列依次取用,
+    // I/O与解码重叠进行
+    class readahead_file_buf final : public block_file_buf {
+        static constexpr size_t BLOCK_BYTES = 4 * 1024 * 1024;
+        static constexpr size_t BLOCK_NUM = 4;
+
+#if TURBOPLY_POSIX_IO
+        int fd_ = -1;
+        bool direct_ = false;       // 绕过页缓存读取 (O_DIRECT或F_NOCACHE), 块偏移与长度都是ALIGNMENT的倍数
+        bool drop_cache_ = false;   // 请求了direct但文件系统不支持: 读取后逐块释放页缓存
+#else
+        std::ifstream file_;        // 只由I/O线程访问
+#endif
+
+        // produced_: 已填充的块数, consumed_: 已归还的块数, 两者之差不超过BLOCK_NUM
+        std::atomic<size_t> produced_{ 0 };
+        std::atomic<size_t> consumed_{ 0 };
+        std::atomic<bool> stop_{ false };
+        std::thread io_;
+
+    public:
+        // direct: 绕过页缓存读取只读一遍的大文件, 不污染其他进程的缓存
+        explicit readahead_file_buf(const std::filesystem::path& filename, bool direct = false)
+            : block_file_buf{ filename, BLOCK_BYTES, BLOCK_NUM } {
+#if TURBOPLY_POSIX_IO
+#if defined(O_DIRECT)
+            if (direct) {
+                fd_ = ::open(filename.c_str(), O_RDONLY | O_DIRECT);
+                direct_ = fd_ >= 0;
+            }
+#endif
+            if (fd_ < 0)
+                fd_ = ::open(filename.c_str(), O_RDONLY);
+            if (fd_ < 0)
+                throw std::runtime_error(std::format("Ply Error: Failed to open file '{}'.", filename.string()));
+#if defined(F_NOCACHE)
+            if (direct && !direct_)
+                direct_ = ::fcntl(fd_, F_NOCACHE, 1) != -1;
+#endif
+            // 两者都不被支持时退回为逐块释放页缓存, 连这也做不到则报错而不是静默地经页缓存读取
+            if (direct && !direct_) {
+#if defined(POSIX_FADV_DONTNEED)
+                drop_cache_ = true;
+#else
+                ::close(fd_);
+                throw std::runtime_error(std::format("Ply Error: Direct I/O is not supported for file '{}'.", filename.string()));
+#endif
+            }
+#if defined(POSIX_FADV_SEQUENTIAL)
+            ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#else
+            if (direct)
+                throw std::runtime_error("Ply Error: The direct I/O backend is not available on this platform.");
+
+            file_.open(filename, std::ios::binary);
+            if (!file_)
+                throw std::runtime_error(std::format("Ply Error: Failed to open file '{}'.", filename.string()));
+#endif
+            restart(0);
+        }
+
+        virtual ~readahead_file_buf() {
+            halt();
+#if TURBOPLY_POSIX_IO
+            ::close(fd_);
+#endif
+        }
+
+    protected:
+        virtual const Block& acquire(size_t seq) override {
+            for (size_t p = produced_.load(std::memory_order_acquire); p <= seq; p = produced_.load(std::memory_order_acquire))
+                produced_.wait(p, std::memory_order_acquire);
+            return ring_[seq % BLOCK_NUM];
+        }
+
+        virtual void release(size_t seq) override {
+            consumed_.store(seq + 1, std::memory_order_release);
+            consumed_.notify_one();
+        }
+
+        virtual void restart(off_type offset) override {
+            halt();
+            produced_.store(0);
+            consumed_.store(0);
+            stop_.store(false);
+            io_ = std::thread([this, offset] { produce(offset); });
+        }
+
+    private:
+        void produce(off_type offset) {
+            for (size_t p = 0;; ++p) {
+                for (size_t c = consumed_.load(std::memory_order_acquire); p - c >= BLOCK_NUM; c = consumed_.load(std::memory_order_acquire)) {
+                    if (stop_.load(std::memory_order_relaxed)) return;
+                    consumed_.wait(c, std::memory_order_acquire);
+                }
+                if (stop_.load(std::memory_order_relaxed)) return;
+
+                Block& b = ring_[p % BLOCK_NUM];
+                b.offset = offset;
+                b.error = 0;
+                b.size = readAt(b.data, block_size_, offset, b.error);
+                offset += static_cast<off_type>(b.size);
+
+                produced_.store(p + 1, std::memory_order_release);
+                produced_.notify_one();
+                if (b.size < block_size_ || b.error) return;
+            }
+        }
+
+        // 读取文件中[offset, offset + n)的部分, 失败时errno记入error (已读的部分照常返回)
+        size_t readAt(char* dst, size_t n, off_type offset, int& error) {
+#if TURBOPLY_POSIX_IO
+#if defined(POSIX_FADV_WILLNEED)
+            // 提示内核继续预读环形缓冲之后的区间
+            if (!direct_)
+                ::posix_fadvise(fd_, offset + static_cast<off_type>(n * BLOCK_NUM), static_cast<off_type>(n), POSIX_FADV_WILLNEED);
+#endif
+            // 只读到文件末尾: O_DIRECT在末尾返回不足的长度, 从其后非对齐的偏移续读会失败
+            const size_t want = offset < file_size_ ? std::min<size_t>(n, static_cast<size_t>(file_size_ - offset)) : 0;
+            size_t done = 0;
+            while (done < want) {
+                const ssize_t r = ::pread(fd_, dst + done, n - done, offset + static_cast<off_type>(done));
+                if (r < 0 && errno == EINTR) continue;
+                if (r < 0) {
+                    error = errno;
+                    break;
+                }
+                if (r == 0) break;  // 文件在读取期间被截短
+
+                // O_DIRECT在文件中途返回不足的长度时退回到对齐处续读
+                const size_t before = done;
+                done += static_cast<size_t>(r);
+                if (direct_ && done < want && done % ALIGNMENT) {
+                    done -= done % ALIGNMENT;
+                    if (done == before) {
+                        error = EIO;
+                        break;
+                    }
                 }
             }
-            return pos_type(off_type(-1)); 
+#if defined(POSIX_FADV_DONTNEED)
+            if (drop_cache_)
+                ::posix_fadvise(fd_, offset, static_cast<off_type>(done), POSIX_FADV_DONTNEED);
+#endif
+            return done;
+#else
+            file_.clear();
+            file_.seekg(offset);
+            file_.read(dst, static_cast<std::streamsize>(n));
+            if (file_.bad()) error = EIO;
+            return static_cast<size_t>(file_.gcount());
+#endif
+        }
+
+        // 停止I/O线程: 推进consumed_以唤醒等待空位的生产者
+        void halt() {
+            if (!io_.joinable()) return;
+
+            stop_.store(true);
+            consumed_.fetch_add(BLOCK_NUM, std::memory_order_release);
+            consumed_.notify_one();
+            io_.join();
+        }
+    };
+
+#if TURBOPLY_IO_URING
+
+    // 最小的io_uring封装 (直接使用系统调用): 提交读写请求, 按完成顺序取回结果
+    class IoUring {
+    public:
+        explicit IoUring(unsigned entries) {
+            io_uring_params params{};
+            fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+            if (fd_ < 0)
+                throw std::runtime_error("Ply Error: io_uring is not available on this system.");
+
+            sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            if (params.features & IORING_FEAT_SINGLE_MMAP)
+                sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+            sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+
+            sq_ptr_ = ::mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+            cq_ptr_ = (params.features & IORING_FEAT_SINGLE_MMAP) ? sq_ptr_
+                : ::mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+            void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+            if (sq_ptr_ == MAP_FAILED || cq_ptr_ == MAP_FAILED || sqes == MAP_FAILED) {
+                unmap();
+                throw std::runtime_error("Ply Error: Failed to map io_uring queues.");
+            }
+            sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+            auto* sq = static_cast<char*>(sq_ptr_);
+            auto* cq = static_cast<char*>(cq_ptr_);
+            sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        }
+
+        ~IoUring() { unmap(); }
+
+        IoUring(const IoUring&) = delete;
+        IoUring& operator=(const IoUring&) = delete;
+
+        // 提交一个读 (IORING_OP_READ) 或写 (IORING_OP_WRITE) 请求
+        void submit(uint8_t opcode, int fd, void* buf, size_t len, off_t offset, uint64_t user_data) {
+            const unsigned tail = *sq_tail_;
+            const unsigned idx = tail & sq_mask_;
+
+            io_uring_sqe& sqe = sqes_[idx];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = opcode;
+            sqe.fd = fd;
+            sqe.addr = reinterpret_cast<uint64_t>(buf);
+            sqe.len = static_cast<unsigned>(len);
+            sqe.off = static_cast<uint64_t>(offset);
+            sqe.user_data = user_data;
+            sq_array_[idx] = idx;
+
+            std::atomic_ref<unsigned>(*sq_tail_).store(tail + 1, std::memory_order_release);
+            enter(1, 0, 0);
+        }
+
+        // 取回一个完成的请求, 没有时等待; 返回user_data, res为传输的字节数或负的错误码
+        uint64_t wait(int& res) {
+            const unsigned head = *cq_head_;
+            while (head == std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire))
+                enter(0, 1, IORING_ENTER_GETEVENTS);
+
+            const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+            res = cqe.res;
+            const uint64_t user_data = cqe.user_data;
+            std::atomic_ref<unsigned>(*cq_head_).store(head + 1, std::memory_order_release);
+            return user_data;
+        }
+
+    private:
+        // 被信号中断 (EINTR) 或内核暂时无法处理 (EAGAIN, EBUSY) 时重试, 其余错误抛出
+        void enter(unsigned to_submit, unsigned min_complete, unsigned flags) {
+            while (::syscall(__NR_io_uring_enter, fd_, to_submit, min_complete, flags, nullptr, 0) < 0) {
+                if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                    throw std::runtime_error(std::format("Ply Error: io_uring_enter failed: {}.", std::strerror(errno)));
+            }
         }
 
-        virtual pos_type seekpos(pos_type sp, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override {
+        void unmap() {
+            if (sqes_) ::munmap(sqes_, sqes_size_);
+            if (cq_ptr_ && cq_ptr_ != MAP_FAILED && cq_ptr_ != sq_ptr_) ::munmap(cq_ptr_, cq_size_);
+            if (sq_ptr_ && sq_ptr_ != MAP_FAILED) ::munmap(sq_ptr_, sq_size_);
+            if (fd_ >= 0) ::close(fd_);
+        }
+
+        int fd_ = -1;
+        void* sq_ptr_ = nullptr;
+        void* cq_ptr_ = nullptr;
+        size_t sq_size_ = 0, cq_size_ = 0, sqes_size_ = 0;
+        io_uring_sqe* sqes_ = nullptr;
+        io_uring_cqe* cqes_ = nullptr;
+        unsigned* sq_tail_ = nullptr;
+        unsigned* sq_array_ = nullptr;
+        unsigned sq_mask_ = 0;
+        unsigned* cq_head_ = nullptr;
+        unsigned* cq_tail_ = nullptr;
+        unsigned cq_mask_ = 0;
+    };
+
+    // io_uring读取: 环形缓冲的每个空闲块都有一个读请求在途, 队列深度即块数
+    class uring_file_buf final : public block_file_buf {
+        static constexpr size_t BLOCK_BYTES = 1024 * 1024;
+        static constexpr size_t BLOCK_NUM = 16;
+
+        int fd_ = -1;
+        IoUring ring_io_{ BLOCK_NUM };
+        std::vector<char> ready_ = std::vector<char>(BLOCK_NUM);
+        size_t issued_ = 0;         // 本轮已提交的块数
+        size_t in_flight_ = 0;
+        off_type next_offset_ = 0;
+
+    public:
+        explicit uring_file_buf(const std::filesystem::path& filename)
+            : block_file_buf{ filename, BLOCK_BYTES, BLOCK_NUM } {
+            fd_ = ::open(filename.c_str(), O_RDONLY);
+            if (fd_ < 0)
+                throw std::runtime_error(std::format("Ply Error: Failed to open file '{}'.", filename.string()));
+            restart(0);
+        }
+
+        // 析构不能抛出: 等待在途请求的失败在此忽略, 需要得知时先调用pubsync()
+        virtual ~uring_file_buf() {
+            try {
+                drain();
+            } catch (...) {
+            }
+            ::close(fd_);
+        }
+
+    protected:
+        virtual int sync() override {
+            drain();
+            return 0;
+        }
+
+        virtual const Block& acquire(size_t seq) override {
+            while (!ready_[seq % BLOCK_NUM])
+                complete();
+            return ring_[seq % BLOCK_NUM];
+        }
+
+        virtual void release(size_t seq) override {
+            ready_[seq % BLOCK_NUM] = 0;
+            issue();
+        }
+
+        virtual void restart(off_type offset) override {
+            drain();
+            std::fill(ready_.begin(), ready_.end(), 0);
+            issued_ = 0;
+            next_offset_ = offset;
+
+            for (size_t i = 0; i < BLOCK_NUM; ++i)
+                issue();
+        }
+
+    private:
+        // 为下一个块提交读请求, 文件之外的块直接标记为空
+        void issue() {
+            const size_t slot = issued_++ % BLOCK_NUM;
+            Block& b = ring_[slot];
+            b.offset = next_offset_;
+            b.size = 0;
+            b.error = 0;
+
+            if (next_offset_ >= file_size_) {
+                ready_[slot] = 1;
+                return;
+            }
+
+            const size_t len = std::min<size_t>(block_size_, static_cast<size_t>(file_size_ - next_offset_));
+            ring_io_.submit(IORING_OP_READ, fd_, b.data, len, next_offset_, slot);
+            ++in_flight_;
+            next_offset_ += static_cast<off_type>(block_size_);
+        }
+
+        void complete() {
+            int res = 0;
+            const size_t slot = static_cast<size_t>(ring_io_.wait(res));
+            --in_flight_;
+
+            // 失败的读取记录错误码, 由underflow抛出; 不足的部分同步补读 (返回0即文件被截短)
+            Block& b = ring_[slot];
+            b.size = res > 0 ? static_cast<size_t>(res) : 0;
+            b.error = res < 0 ? -res : 0;
+
+            const size_t want = std::min<size_t>(block_size_, static_cast<size_t>(file_size_ - b.offset));
+            while (res > 0 && b.size < want) {
+                const ssize_t r = ::pread(fd_, b.data + b.size, want - b.size, b.offset + static_cast<off_type>(b.size));
+                if (r < 0 && errno == EINTR) continue;
+                if (r < 0) b.error = errno;
+                if (r <= 0) break;
+                b.size += static_cast<size_t>(r);
+            }
+            ready_[slot] = 1;
+        }
+
+        void drain() {
+            while (in_flight_)
+                complete();
+        }
+    };
+
+    // io_uring写入: 写满的块提交后继续填充下一个块, 所有块都在途时等待最早的完成
+    class uring_write_buf final : public std::streambuf {
+        static constexpr size_t BLOCK_BYTES = 1024 * 1024;
+        static constexpr size_t BLOCK_NUM = 8;
+        static constexpr size_t ALIGNMENT = 4096;
+
+        int fd_ = -1;
+        IoUring ring_io_{ BLOCK_NUM };
+        std::unique_ptr<char[]> storage_;
+        std::vector<char> busy_ = std::vector<char>(BLOCK_NUM);
+        std::vector<size_t> sizes_ = std::vector<size_t>(BLOCK_NUM);
+        std::vector<off_type> offsets_ = std::vector<off_type>(BLOCK_NUM);
+        size_t current_ = 0;
+        size_t in_flight_ = 0;
+        off_type offset_ = 0;       // 当前块在文件中的偏移
+        bool failed_ = false;
+
+    public:
+        explicit uring_write_buf(const std::filesystem::path& filename) {
+            fd_ = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd_ < 0)
+                throw std::runtime_error(std::format("Ply Error: Failed to open file '{}'.", filename.string()));
+
+            storage_ = std::make_unique<char[]>(BLOCK_BYTES * BLOCK_NUM + ALIGNMENT);
+            setp(block(0), block(0) + BLOCK_BYTES);
+        }
+
+        // 析构不能抛出: 写出的失败在此忽略, 由PlyFileHandler::close()或显式的flush报告
+        virtual ~uring_write_buf() {
+            try {
+                sync();
+            } catch (...) {
+            }
+            ::close(fd_);
+        }
+
+    protected:
+        virtual int_type overflow(int_type c) override {
+            if (!submit()) return traits_type::eof();
+
+            if (!traits_type::eq_int_type(c, traits_type::eof())) {
+                *pptr() = traits_type::to_char_type(c);
+                pbump(1);
+            }
+            return traits_type::not_eof(c);
+        }
+
+        virtual int sync() override {
+            if (!submit()) return -1;
+
+            while (in_flight_)
+                complete();
+            return failed_ ? -1 : 0;
+        }
+
+        // 向后定位到已写的位置 (如ASCII行尾回退一个字节): 当前块内直接移动写指针,
+        // 位于已提交的块中时先写完全部块, 再从目标处开始新的块 (之后的写入覆盖原有内容)
+        virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+            std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override {
+            const off_type pos = offset_ + (pptr() - pbase());
+            const off_type target = dir == std::ios_base::cur ? pos + off : dir == std::ios_base::beg ? off : off_type(-1);
+            if (!(which & std::ios_base::out) || target < 0 || target > pos)
+                return pos_type(off_type(-1));
+
+            if (target < offset_) {
+                if (sync() != 0) return pos_type(off_type(-1));
+                offset_ = target;
+                return target;
+            }
+
+            pbump(static_cast<int>(target - pos));
+            return target;
+        }
+
+        virtual pos_type seekpos(pos_type sp,
+            std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override {
             return seekoff(off_type(sp), std::ios_base::beg, which);
         }
+
+    private:
+        char* block(size_t i) {
+            char* base = storage_.get() + (ALIGNMENT - reinterpret_cast<uintptr_t>(storage_.get()) % ALIGNMENT) % ALIGNMENT;
+            return base + i * BLOCK_BYTES;
+        }
+
+        // 提交当前块并切换到下一个空闲块
+        bool submit() {
+            const size_t n = static_cast<size_t>(pptr() - pbase());
+            if (n == 0) return !failed_;
+
+            ring_io_.submit(IORING_OP_WRITE, fd_, pbase(), n, offset_, current_);
+            busy_[current_] = 1;
+            sizes_[current_] = n;
+            offsets_[current_] = offset_;
+            ++in_flight_;
+            offset_ += static_cast<off_type>(n);
+
+            current_ = (current_ + 1) % BLOCK_NUM;
+            while (busy_[current_])
+                complete();
+
+            setp(block(current_), block(current_) + BLOCK_BYTES);
+            return !failed_;
+        }
+
+        void complete() {
+            int res = 0;
+            const size_t slot = static_cast<size_t>(ring_io_.wait(res));
+            --in_flight_;
+            busy_[slot] = 0;
+            if (res < 0) {
+                failed_ = true;
+                return;
+            }
+
+            // 不足的部分同步补写
+            for (size_t done = static_cast<size_t>(res); done < sizes_[slot];) {
+                const ssize_t r = ::pwrite(fd_, block(slot) + done, sizes_[slot] - done, offsets_[slot] + static_cast<off_type>(done));
+                if (r <= 0) {
+                    failed_ = true;
+                    return;
+                }
+                done += static_cast<size_t>(r);
+            }
+        }
     };
 
+#endif
+
+    // 只读的内存字节
+    class memory_read_buf : public turboply::detail::MemoryStreamBuf {
+    public:
+        explicit memory_read_buf(std::span<const std::byte> data) {
+            char* p = const_cast<char*>(reinterpret_cast<const char*>(data.data()));
+            setg(p, p, p + data.size());
+        }
+    };
+
+    // 写入内存: 自有的缓冲按需倍增, 调用方提供的缓冲写满即失败
+    class memory_write_buf : public turboply::detail::MemoryStreamBuf {
+        static constexpr size_t INITIAL_SIZE = 64 * 1024;
+
+        std::vector<std::byte> owned_;
+        bool growable_;
+
+    public:
+        memory_write_buf() : owned_(INITIAL_SIZE), growable_{ true } {
+            reset(owned_.data(), owned_.size(), 0);
+        }
+
+        explicit memory_write_buf(std::span<std::byte> buffer) : growable_{ false } {
+            reset(buffer.data(), buffer.size(), 0);
+        }
+
+        virtual std::span<std::byte> reserve(size_t n) override {
+            if (static_cast<size_t>(epptr() - pptr()) < n) {
+                if (!growable_) return {};
+                grow(n);
+            }
+            return { reinterpret_cast<std::byte*>(pptr()), n };
+        }
+
+        std::span<const std::byte> written() const {
+            return { reinterpret_cast<const std::byte*>(pbase()), static_cast<size_t>(pptr() - pbase()) };
+        }
+
+        std::vector<std::byte> release() {
+            if (!growable_)
+                throw std::runtime_error("Ply Write Error: Only a growable memory writer can release its buffer.");
+
+            owned_.resize(written().size());
+            std::vector<std::byte> out = std::move(owned_);
+            owned_.resize(INITIAL_SIZE);
+            reset(owned_.data(), owned_.size(), 0);
+            return out;
+        }
+
+    protected:
+        virtual int_type overflow(int_type c) override {
+            if (traits_type::eq_int_type(c, traits_type::eof()))
+                return traits_type::not_eof(c);
+
+            auto dst = reserve(1);
+            if (dst.empty()) full(1);
+
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+            return c;
+        }
+
+        virtual std::streamsize xsputn(const char* s, std::streamsize n) override {
+            auto dst = reserve(static_cast<size_t>(n));
+            if (dst.empty() && n > 0) full(static_cast<size_t>(n));
+
+            std::memcpy(dst.data(), s, static_cast<size_t>(n));
+            commit(static_cast<size_t>(n));
+            return n;
+        }
+
+    private:
+        void reset(std::byte* data, size_t size, size_t used) {
+            char* p = reinterpret_cast<char*>(data);
+            setp(p, p + size);
+            commit(used);
+        }
+
+        void grow(size_t n) {
+            const size_t used = written().size();
+            owned_.resize(std::max(owned_.size() * 2, used + n));
+            reset(owned_.data(), owned_.size(), used);
+        }
+
+        [[noreturn]] void full(size_t n) const {
+            throw std::runtime_error(std::format("Ply Write Error: Memory buffer of {} bytes cannot hold {} more bytes.",
+                epptr() - pbase(), n));
+        }
+    };
+
+}
+
+namespace turboply {
+
+std::streambuf::pos_type detail::MemoryStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) {
+    if ((which & std::ios_base::in) && eback()) {
+        char* target = nullptr;
+        if (dir == std::ios_base::beg)      target = eback() + off;
+        else if (dir == std::ios_base::cur) target = gptr() + off;
+        else if (dir == std::ios_base::end) target = egptr() + off;
+
+        if (target >= eback() && target <= egptr()) {
+            setg(eback(), target, egptr());
+            return target - eback();
+        }
+    }
+    else if (which & std::ios_base::out) {
+        char* target = nullptr;
+        if (dir == std::ios_base::beg)      target = pbase() + off;
+        else if (dir == std::ios_base::cur) target = pptr() + off;
+        else if (dir == std::ios_base::end) target = epptr() + off;
+
+        if (target >= pbase() && target <= epptr()) {
+            setp(pbase(), epptr()); 
+            pbump(static_cast<int>(target - pptr())); 
+            return target - pbase();
+        }
+    }
+    return pos_type(off_type(-1)); 
+}
+
+std::streambuf::pos_type detail::MemoryStreamBuf::seekpos(pos_type sp, std::ios_base::openmode which) {
+    return seekoff(off_type(sp), std::ios_base::beg, which);
+}
+
+void detail::MemoryStreamBuf::commit(size_t n) {
+    // pbump只接受int
+    for (constexpr size_t step = std::numeric_limits<int>::max(); n > step; n -= step)
+        pbump(static_cast<int>(step));
+    pbump(static_cast<int>(n));
 }
 
+detail::PagePrefault::PagePrefault(std::vector<std::span<std::byte>> ranges) {
+#if defined(MADV_POPULATE_WRITE)
+    static constexpr size_t MIN_BYTES = 16 * 1024 * 1024;
+    static constexpr size_t CHUNK_BYTES = 2 * 1024 * 1024;
+
+    size_t total = 0;
+    for (const auto& r : ranges) total += r.size();
+    if (total < MIN_BYTES) return;
+
+    // 只写缺页, 不改内容: 已被解码写过的页不受影响; 内核不支持时放弃
+    _thread = std::jthread([ranges = std::move(ranges)](std::stop_token stop) {
+        const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        for (const auto& r : ranges) {
+            uintptr_t p = (reinterpret_cast<uintptr_t>(r.data()) + page - 1) & ~(page - 1);
+            const uintptr_t end = (reinterpret_cast<uintptr_t>(r.data()) + r.size()) & ~(page - 1);
+
+            for (; p < end && !stop.stop_requested(); p += CHUNK_BYTES) {
+                if (madvise(reinterpret_cast<void*>(p), std::min<uintptr_t>(CHUNK_BYTES, end - p), MADV_POPULATE_WRITE) != 0)
+                    return;
+            }
+        }
+    });
 #endif
+}
 
-namespace turboply {
+//////////////////////////////////////////////////////////////////////////
 
 PlyFormat detectPlyFormat(const std::filesystem::path& filename) {
     std::ifstream ifs(filename);
@@ -83,6 +843,12 @@ PlyFormat detectPlyFormat(const std::filesystem::path& filename) {
     ifs.read(header.data(), N);
     header.resize(static_cast<size_t>(ifs.gcount()));
 
+    return detectPlyFormat(std::as_bytes(std::span{ header }));
+}
+
+PlyFormat detectPlyFormat(std::span<const std::byte> data) {
+    const std::string_view header{ reinterpret_cast<const char*>(data.data()), std::min<size_t>(data.size(), 1024) };
+
     bool found_ascii = (header.find("format ascii") != std::string::npos);
     bool found_bin_le = (header.find("format binary_little_endian") != std::string::npos);
 
@@ -98,18 +864,29 @@ template <class StreamHandler>
     requires std::same_as<StreamHandler, PlyStreamReader> || std::same_as<StreamHandler, PlyStreamWriter>
 PlyFileHandler<StreamHandler>::PlyFileHandler(Resources&& res, PlyFormat format)
     : StreamHandler{ *res.second, format }
-    , _mapped_buf{ std::move(res.first) }
+    , _file_buf{ std::move(res.first) }
     , _managed_stream{ std::move(res.second) } {
 }
 
 template <class StreamHandler>
     requires std::same_as<StreamHandler, PlyStreamReader> || std::same_as<StreamHandler, PlyStreamWriter>
 typename PlyFileHandler<StreamHandler>::Resources
-    PlyFileHandler<StreamHandler>::init(const std::filesystem::path& filename, bool use_mapping, size_t reserve_size) {
+    PlyFileHandler<StreamHandler>::init(const std::filesystem::path& filename, PlyFileBackend backend, size_t reserve_size) {
     constexpr bool is_reader = std::is_same_v<StreamT, std::istream>;
     Resources res;
 
-    if (use_mapping) {
+    if (backend == PlyFileBackend::IO_URING) {
+#if TURBOPLY_IO_URING
+        if constexpr (is_reader)
+            res.first = std::make_unique<uring_file_buf>(filename);
+        else
+            res.first = std::make_unique<uring_write_buf>(filename);
+        res.second = std::make_unique<StreamT>(res.first.get());
+#else
+        throw std::runtime_error("Ply Error: The io_uring backend is only available on Linux.");
+#endif
+    }
+    else if (backend == PlyFileBackend::MAPPING) {
 #if TURBOPLY_ENABLE_FILE_MAPPING
         try {
             res.first = std::make_unique<mapped_file_buf>(filename.c_str(), is_reader, reserve_size);
@@ -121,27 +898,94 @@ typename PlyFileHandler<StreamHandler>::Resources
         throw std::runtime_error("Ply Error: File mapping is disabled in this build (TURBOPLY_ENABLE_FILE_MAPPING is off).");
 #endif
     }
+    else if constexpr (is_reader) {
+        res.first = std::make_unique<readahead_file_buf>(filename, backend == PlyFileBackend::DIRECT);
+        res.second = std::make_unique<StreamT>(res.first.get());
+    }
     else {
-        if constexpr (is_reader)
-            res.second = std::make_unique<std::ifstream>(filename, std::ios::binary);
-        else
-            res.second = std::make_unique<std::ofstream>(filename, std::ios::binary);
+        if (backend == PlyFileBackend::DIRECT)
+            throw std::runtime_error("Ply Error: The direct I/O backend only supports reading.");
 
+        res.second = std::make_unique<std::ofstream>(filename, std::ios::binary);
         if (!res.second->good())
             throw std::runtime_error(std::format("Ply Error: Failed to open file '{}'.", filename.string()));
     }
 
+    // 文件缓冲的读取错误以异常抛出, istream默认只置badbit, 之后被当作数据结束; 打开badbit异常使原异常传给调用者
+    if constexpr (is_reader)
+        res.second->exceptions(std::ios::badbit);
+
     return res;
 }
 
 template <class StreamHandler>
     requires std::same_as<StreamHandler, PlyStreamReader> || std::same_as<StreamHandler, PlyStreamWriter>
 void PlyFileHandler<StreamHandler>::close() {
+    // 缓冲中未完成的I/O在此完成并报告错误; 析构时的错误被忽略
+    bool failed = false;
+    if (_file_buf)
+        failed = _file_buf->pubsync() == -1;
+    else if constexpr (std::is_same_v<StreamT, std::ostream>)
+        failed = _managed_stream && !_managed_stream->flush();
+
     _managed_stream.reset();
-    _mapped_buf.reset();
+    _file_buf.reset();
+
+    if (failed)
+        throw std::runtime_error("Ply Error: Failed to write file.");
 }
 
 template class PlyFileHandler<PlyStreamReader>;
 template class PlyFileHandler<PlyStreamWriter>;
 
+//////////////////////////////////////////////////////////////////////////
+
+PlyMemoryReader::PlyMemoryReader(std::span<const std::byte> data)
+    : PlyMemoryReader{ init(data), detectPlyFormat(data) } {
+}
+
+PlyMemoryReader::PlyMemoryReader(Resources&& res, PlyFormat format)
+    : PlyStreamReader{ *res.second, format }
+    , _buf{ std::move(res.first) }
+    , _managed_stream{ std::move(res.second) } {
+}
+
+PlyMemoryReader::Resources PlyMemoryReader::init(std::span<const std::byte> data) {
+    Resources res;
+    res.first = std::make_unique<memory_read_buf>(data);
+    res.second = std::make_unique<std::istream>(res.first.get());
+    return res;
+}
+
+PlyMemoryWriter::PlyMemoryWriter(PlyFormat format)
+    : PlyMemoryWriter{ init(std::make_unique<memory_write_buf>()), format } {
+}
+
+PlyMemoryWriter::PlyMemoryWriter(std::span<std::byte> buffer, PlyFormat format)
+    : PlyMemoryWriter{ init(std::make_unique<memory_write_buf>(buffer)), format } {
+}
+
+PlyMemoryWriter::PlyMemoryWriter(Resources&& res, PlyFormat format)
+    : PlyStreamWriter{ *res.second, format }
+    , _buf{ std::move(res.first) }
+    , _managed_stream{ std::move(res.second) } {
+    // 调用方的缓冲写满时由streambuf抛出异常
+    _managed_stream->exceptions(std::ios::badbit);
+}
+
+PlyMemoryWriter::Resources PlyMemoryWriter::init(std::unique_ptr<std::streambuf> buf) {
+    Resources res;
+    res.second = std::make_unique<std::ostream>(buf.get());
+    res.first = std::move(buf);
+    return res;
+}
+
+std::span<const std::byte> PlyMemoryWriter::data() const {
+    return static_cast<const memory_write_buf*>(_buf.get())->written();
+}
+
+std::vector<std::byte> PlyMemoryWriter::release() {
+    return static_cast<memory_write_buf*>(_buf.get())->release();
+}
+
 }
@@ -1,6 +1,24 @@
 #include "turboply.hpp"
 #include <cassert>
+#include <cstring>
+#include <utility>
+#include <algorithm>
 #include <stdexcept>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <bit>
+#include <limits>
+#include <charconv>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <unordered_set>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TURBOPLY_SSE2 1
+#include <immintrin.h>
+#endif
 
 namespace turboply {
 
@@ -232,6 +250,7 @@ void PlyStreamReader::parseHeader() {
         }
     }
 
+    _body_offset = _is.tellg();
     _has_header = true;
 }
 
@@ -251,6 +270,1331 @@ PlyScalar PlyStreamReader::readScalar(ScalarKind k) {
 
 //////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+    // 列表长度须为非负整数, 且长度乘以值的大小 (至多8字节) 不会溢出
+    size_t loadListCount(const std::byte* p, ScalarKind k) {
+        constexpr uint64_t MAX_COUNT = uint64_t{ 1 } << 52;
+
+        return detail::visit_scalar_kind(k, [&]<typename T>() -> size_t {
+            const T v = detail::load_scalar<T>(p);
+
+            bool valid;
+            if constexpr (std::is_floating_point_v<T>)
+                valid = v >= 0 && v <= static_cast<T>(MAX_COUNT) && static_cast<T>(static_cast<uint64_t>(v)) == v;
+            else
+                valid = std::cmp_greater_equal(v, 0) && std::cmp_less_equal(v, MAX_COUNT);
+
+            if (!valid)
+                throw std::runtime_error(std::format("Ply Read Error: Invalid list length {}.", +v));
+            return static_cast<size_t>(v);
+        });
+    }
+
+    void storeListCount(std::byte* p, size_t n, ScalarKind k) {
+        detail::visit_scalar_kind(k, [&]<typename T>() {
+            const T v = static_cast<T>(n);
+            std::memcpy(p, &v, sizeof(T));
+        });
+    }
+
+    bool hasListColumns(const detail::ElementReadPlan& plan) {
+        return std::any_of(plan.bindings.begin(), plan.bindings.end(), [](const auto& b) { return b.column; });
+    }
+
+    // 第ri行的列表写入绑定: CSR列的偏移未预先统计时接在上一行之后 (须按行顺序解码), 否则写入行内的容器
+    void assignList(const detail::PropertyBinding& b, size_t ri, const std::byte* src, size_t count, size_t vsize) {
+        auto* c = b.column;
+        if (!c) {
+            b.assign(b.dst + ri * b.dstStride, src, count, vsize, b.copy);
+            return;
+        }
+
+        const uint64_t first = c->offsets[ri];
+        if (!c->counted) {
+            if (first + count > c->capacity)
+                c->reserve(*c, first + count);
+            c->offsets[ri + 1] = first + count;
+        }
+        b.copy(src, vsize, c->values + first * c->valueSize, c->valueSize, count);
+    }
+
+    // 与AsciiHandler一致: 最短表示后接一个空格
+    void formatScalar(std::vector<char>& out, const std::byte* p, ScalarKind k) {
+        char buf[64];
+        char* end = detail::visit_scalar_kind(k, [&]<typename T>() {
+            return std::to_chars(buf, buf + sizeof(buf), detail::load_scalar<T>(p)).ptr;
+        });
+        *end++ = ' ';
+        out.insert(out.end(), buf, end);
+    }
+
+    // 整数走逐位累加的快速路径 (过长的token交给from_chars), 浮点直接对原始指针调用from_chars
+    // 与AsciiHandler一致, 只要求token以合法数值开头 (如整数属性中的 "1.0" 读为1)
+    template <typename T>
+    bool parseToken(const char* p, const char* end, T& v) {
+        if constexpr (std::is_integral_v<T>) {
+            const bool neg = p < end && *p == '-';
+            const char* digits = p + (neg || (p < end && *p == '+'));
+            if (end - digits > 18)
+                return std::from_chars(p, end, v).ec == std::errc();
+
+            uint64_t x = 0;
+            const char* q = digits;
+            for (; q < end; ++q) {
+                const unsigned d = static_cast<unsigned>(*q - '0');
+                if (d > 9) break;
+                x = x * 10 + d;
+            }
+            if (q == digits) return false;
+
+            if (neg) {
+                if (x > static_cast<uint64_t>(-static_cast<int64_t>(std::numeric_limits<T>::min()))) return false;
+                v = static_cast<T>(-static_cast<int64_t>(x));
+            }
+            else {
+                if (x > static_cast<uint64_t>(std::numeric_limits<T>::max())) return false;
+                v = static_cast<T>(x);
+            }
+            return true;
+        }
+        else {
+            return std::from_chars(p, end, v).ec == std::errc();
+        }
+    }
+
+    void parseScalar(std::string_view token, ScalarKind k, std::byte* dst) {
+        const bool ok = detail::visit_scalar_kind(k, [&]<typename T>() {
+            T v{};
+            if (!parseToken(token.data(), token.data() + token.size(), v)) return false;
+            std::memcpy(dst, &v, sizeof(T));
+            return true;
+        });
+
+        if (!ok)
+            throw std::runtime_error(std::format("Ply Read Error: Failed to parse ASCII value '{}'.", token));
+    }
+
+    // ASCII词法扫描: 直接在内存区间 (映射文件) 上, 或在逐行读入的缓冲上切分token
+    class AsciiScanner {
+    public:
+        AsciiScanner(const char* begin, const char* end) : _p{ begin }, _end{ end } {}
+        explicit AsciiScanner(std::istream& is) : _is{ &is } {}
+
+        // 前进到下一个token的起始处, 必要时读入下一行
+        bool seekToken() {
+            for (;;) {
+                while (_p < _end && static_cast<unsigned char>(*_p) <= ' ') ++_p;
+                if (_p < _end) return true;
+
+                if (!_is || !std::getline(*_is, _line)) return false;
+                _p = _line.data();
+                _end = _p + _line.size();
+            }
+        }
+
+        bool next(std::string_view& token) {
+            if (!seekToken()) return false;
+
+            const char* e = findSpace(_p, _end);
+            token = { _p, static_cast<size_t>(e - _p) };
+            _p = e;
+            return true;
+        }
+
+        // 丢弃当前行剩余的token
+        void skipLine() {
+            if (_is) {
+                _p = _end;
+                return;
+            }
+
+            const char* nl = static_cast<const char*>(std::memchr(_p, '\n', _end - _p));
+            _p = nl ? nl + 1 : _end;
+        }
+
+        const char* position() const { return _p; }
+
+    private:
+        static const char* findSpace(const char* p, const char* end) {
+#if TURBOPLY_SSE2
+            const __m128i space = _mm_set1_epi8(' ');
+            for (; p + 16 <= end; p += 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(v, space), v)));
+                if (mask) return p + std::countr_zero(mask);
+            }
+#endif
+            while (p < end && static_cast<unsigned char>(*p) > ' ') ++p;
+            return p;
+        }
+
+        const char* _p = nullptr;
+        const char* _end = nullptr;
+        std::istream* _is = nullptr;
+        std::string _line;
+    };
+
+    // 解码n行ASCII行, 未绑定的属性只切分不解析, 最后一个绑定属性之后的部分按行跳过
+    void decodeAsciiRows(const detail::ElementReadPlan& plan, AsciiScanner& scanner, size_t r0, size_t n) {
+        const auto& elem = *plan.element;
+        const auto& props = elem.properties;
+
+        size_t tail = props.size();
+        while (tail > 0 && !plan.bindings[tail - 1].copy) --tail;
+
+        const auto overrun = [&elem]() {
+            return std::runtime_error(std::format("Ply Read Error: Unexpected end of data in element '{}'.", elem.name));
+        };
+        auto token = [&]() {
+            std::string_view t;
+            if (!scanner.next(t)) throw overrun();
+            return t;
+        };
+
+        std::vector<std::byte> values(256);
+        std::byte value[8];
+
+        for (size_t ri = r0; ri < r0 + n; ++ri) {
+            for (size_t pi = 0; pi < tail; ++pi) {
+                const auto& prop = props[pi];
+                const auto& b = plan.bindings[pi];
+
+                if (prop.listKind == ScalarKind::UNUSED) {
+                    const auto t = token();
+                    if (!b.copy) continue;
+
+                    parseScalar(t, prop.valueKind, value);
+                    b.copy(value, 0, b.dst + ri * b.dstStride, 0, 1);
+                    continue;
+                }
+
+                parseScalar(token(), prop.listKind, value);
+                const size_t count = loadListCount(value, prop.listKind);
+
+                if (!b.assign && !b.column) {
+                    for (size_t k = 0; k < count; ++k) token();
+                    continue;
+                }
+
+                // 按实际读到的值扩容, 长度与数据不符时在数据末尾处报错
+                const size_t vsize = scalarKindSize(prop.valueKind);
+                for (size_t k = 0; k < count; ++k) {
+                    if (values.size() < (k + 1) * vsize)
+                        values.resize(std::max(values.size() * 2, (k + 1) * vsize));
+                    parseScalar(token(), prop.valueKind, values.data() + k * vsize);
+                }
+                assignList(b, ri, values.data(), count, vsize);
+            }
+
+            if (tail < props.size()) {
+                // 整行未绑定时先定位到本行
+                if (tail == 0 && !scanner.seekToken()) throw overrun();
+                scanner.skipLine();
+            }
+        }
+    }
+
+    size_t rowLayout(const PlyElement& elem, std::vector<size_t>& offsets) {
+        size_t offset = 0;
+        bool fixed = true;
+        for (size_t pi = 0; pi < elem.properties.size(); ++pi) {
+            offsets[pi] = offset;
+            offset += scalarKindSize(elem.properties[pi].valueKind);
+            fixed &= elem.properties[pi].listKind == ScalarKind::UNUSED;
+        }
+
+        return fixed ? offset : 0;
+    }
+
+    struct ColumnRun {
+        size_t offset;
+        size_t size;
+        std::byte* dst;
+        size_t dstStride;
+    };
+
+    // 按位拷贝 (类型一致, 或非饱和的同宽整数如int -> uint) 且在文件行和目标行中都相邻的属性合并为一段字节拷贝,
+    // 其余属性逐列转换
+    void splitColumnRuns(const detail::ElementReadPlan& plan, std::vector<ColumnRun>& runs, std::vector<size_t>& converts) {
+        const auto& props = plan.element->properties;
+
+        for (size_t pi = 0; pi < props.size(); ++pi) {
+            const auto& b = plan.bindings[pi];
+            if (!b.copy) continue;
+
+            if (b.copy != detail::convertKernel(props[pi].valueKind, props[pi].valueKind)) {
+                converts.push_back(pi);
+                continue;
+            }
+
+            const size_t size = scalarKindSize(props[pi].valueKind);
+            if (!runs.empty()) {
+                auto& last = runs.back();
+                if (last.offset + last.size == plan.offsets[pi] && last.dst + last.size == b.dst && last.dstStride == b.dstStride) {
+                    last.size += size;
+                    continue;
+                }
+            }
+
+            runs.push_back({ plan.offsets[pi], size, b.dst, b.dstStride });
+        }
+    }
+
+    // 把列表展开为长度标量加arity个值标量, 得到等效的定长元素
+    void expandProperties(const PlyElement& elem, const std::vector<size_t>& arity, PlyElement& fixed) {
+        fixed = PlyElement{ elem.name, elem.count, {} };
+        for (size_t pi = 0; pi < elem.properties.size(); ++pi) {
+            const auto& prop = elem.properties[pi];
+            if (prop.listKind == ScalarKind::UNUSED) {
+                fixed.properties.push_back(prop);
+                continue;
+            }
+
+            fixed.properties.push_back({ prop.name, prop.listKind });
+            fixed.properties.insert(fixed.properties.end(), arity[pi], { prop.name, prop.valueKind });
+        }
+    }
+
+    // 以首行的列表长度作为各行的假定长度, 批量检查每行的长度都与假定一致时返回定长行的大小, 否则返回0
+    size_t checkFixedArity(const PlyElement& elem, std::span<const std::byte> data, std::vector<size_t>& arity) {
+        constexpr size_t MAX_ARITY = 16;
+
+        struct CountCheck {
+            size_t offset;
+            ScalarKind kind;
+            size_t count;
+        };
+        std::vector<CountCheck> checks;
+
+        arity.assign(elem.properties.size(), 0);
+
+        size_t offset = 0;
+        for (size_t pi = 0; pi < elem.properties.size(); ++pi) {
+            const auto& prop = elem.properties[pi];
+            if (prop.listKind == ScalarKind::UNUSED) {
+                offset += scalarKindSize(prop.valueKind);
+                continue;
+            }
+
+            if (offset + scalarKindSize(prop.listKind) > data.size()) return 0;
+            const size_t n = loadListCount(data.data() + offset, prop.listKind);
+            if (n > MAX_ARITY) return 0;
+
+            arity[pi] = n;
+            checks.push_back({ offset, prop.listKind, n });
+            offset += scalarKindSize(prop.listKind) + n * scalarKindSize(prop.valueKind);
+        }
+
+        const size_t stride = offset;
+        if (checks.empty() || stride == 0 || elem.count > data.size() / stride) return 0;
+
+        for (const auto& c : checks) {
+            const std::byte* p = data.data() + c.offset;
+            if (scalarKindSize(c.kind) == 1) {
+                const auto expected = static_cast<std::byte>(c.count);
+                for (size_t ri = 0; ri < elem.count; ++ri)
+                    if (p[ri * stride] != expected) return 0;
+            }
+            else {
+                for (size_t ri = 0; ri < elem.count; ++ri)
+                    if (loadListCount(p + ri * stride, c.kind) != c.count) return 0;
+            }
+        }
+
+        return stride;
+    }
+
+    // 列表长度恒定时展开为定长元素并返回定长行的大小, 否则返回0
+    // cache为所属元素的检查结果: 已检查时直接使用 (元素的任一部分行都与整个元素一致), 否则检查整个元素时记入
+    size_t expandFixedArity(detail::FixedArity* cache, const PlyElement& elem, std::span<const std::byte> data
+        , PlyElement& fixed, std::vector<size_t>& arity) {
+        size_t stride = 0;
+        if (cache && cache->checked) {
+            if (!cache->stride || elem.count > data.size() / cache->stride) return 0;
+            stride = cache->stride;
+            arity = cache->arity;
+        }
+        else {
+            stride = checkFixedArity(elem, data, arity);
+            if (cache && elem.count == cache->rows)
+                *cache = detail::FixedArity{ cache->rows, true, stride, arity };
+        }
+
+        if (stride) expandProperties(elem, arity, fixed);
+        return stride;
+    }
+
+    // 列表展开后的定长读取计划, 列表的值绑定到定长容器的各个分量
+    // 绑定的列表须为长度与文件一致的定长容器, 否则返回空
+    std::optional<detail::ElementReadPlan> fixedArityPlan(detail::FixedArity* cache, const detail::ElementReadPlan& plan
+        , std::span<const std::byte> data, PlyElement& fixed) {
+        const auto& props = plan.element->properties;
+        for (const auto& b : plan.bindings) {
+            if (b.assign && (!b.arity || b.dstKind == ScalarKind::UNUSED)) return std::nullopt;
+        }
+
+        std::vector<size_t> arity;
+        if (!expandFixedArity(cache, *plan.element, data, fixed, arity)) return std::nullopt;
+
+        for (size_t pi = 0; pi < props.size(); ++pi) {
+            if (plan.bindings[pi].assign && plan.bindings[pi].arity != arity[pi]) return std::nullopt;
+        }
+
+        // 定长列表的CSR值区即为count行arity列的稠密数组
+        for (size_t pi = 0; pi < props.size(); ++pi) {
+            auto* c = plan.bindings[pi].column;
+            if (!c) continue;
+
+            c->reserve(*c, plan.element->count * arity[pi]);
+            for (size_t ri = 0; ri <= plan.element->count; ++ri)
+                c->offsets[ri] = ri * arity[pi];
+            c->counted = true;
+        }
+
+        std::optional<detail::ElementReadPlan> fixed_plan{ std::in_place, fixed };
+        for (size_t pi = 0, fi = 0; pi < props.size(); ++pi) {
+            const auto& b = plan.bindings[pi];
+            if (props[pi].listKind == ScalarKind::UNUSED) {
+                fixed_plan->bindings[fi++] = b;
+                continue;
+            }
+
+            ++fi; // 列表长度不绑定
+            for (size_t k = 0; k < arity[pi]; ++k, ++fi) {
+                if (!b.assign && !b.column) continue;
+
+                auto& vb = fixed_plan->bindings[fi];
+                vb = b;
+                vb.assign = nullptr;
+                vb.column = nullptr;
+                if (b.column) {
+                    vb.dst = b.column->values + k * b.column->valueSize;
+                    vb.dstStride = arity[pi] * b.column->valueSize;
+                }
+                else {
+                    vb.dst = b.dst + k * scalarKindSize(b.dstKind);
+                }
+            }
+        }
+
+        return fixed_plan;
+    }
+
+    // 跳过一个二进制元素, 只读取列表长度
+    // chunk_offsets非空时记录每chunk_rows行的起始偏移; columns非空时其CSR列的offsets填为列表长度的前缀和并分配值区
+    size_t scanElementSize(detail::FixedArity* cache, const PlyElement& elem, std::span<const std::byte> data
+        , size_t chunk_rows = 0, std::vector<size_t>* chunk_offsets = nullptr, const detail::ElementReadPlan* columns = nullptr) {
+        const auto overrun = [&elem]() {
+            return std::runtime_error(std::format("Ply Read Error: Unexpected end of data in element '{}'.", elem.name));
+        };
+
+        detail::ElementReadPlan plan{ elem };
+        if (plan.stride) {
+            if (elem.count > data.size() / plan.stride) throw overrun();
+            return elem.count * plan.stride;
+        }
+
+        std::vector<detail::ListColumn*> lists(elem.properties.size());
+        for (size_t pi = 0; columns && pi < lists.size(); ++pi)
+            lists[pi] = columns->bindings[pi].column;
+
+        auto counted = [&]() {
+            for (auto* c : lists) {
+                if (!c) continue;
+                c->reserve(*c, c->offsets[elem.count]);
+                c->counted = true;
+            }
+        };
+
+        PlyElement fixed;
+        std::vector<size_t> arity;
+        if (const size_t stride = expandFixedArity(cache, elem, data, fixed, arity)) {
+            for (size_t ri = 0; chunk_offsets && ri < elem.count; ri += chunk_rows)
+                chunk_offsets->push_back(ri * stride);
+
+            for (size_t pi = 0; pi < lists.size(); ++pi) {
+                for (size_t ri = 0; lists[pi] && ri <= elem.count; ++ri)
+                    lists[pi]->offsets[ri] = ri * arity[pi];
+            }
+            counted();
+            return elem.count * stride;
+        }
+
+        size_t pos = 0;
+        for (size_t ri = 0; ri < elem.count; ++ri) {
+            if (chunk_offsets && ri % chunk_rows == 0)
+                chunk_offsets->push_back(pos);
+
+            for (size_t pi = 0; pi < lists.size(); ++pi) {
+                const auto& prop = elem.properties[pi];
+                if (prop.listKind == ScalarKind::UNUSED) {
+                    pos += scalarKindSize(prop.valueKind);
+                    continue;
+                }
+
+                const size_t count_size = scalarKindSize(prop.listKind);
+                if (pos + count_size > data.size()) throw overrun();
+                const size_t count = loadListCount(data.data() + pos, prop.listKind);
+                if (count > (data.size() - pos - count_size) / scalarKindSize(prop.valueKind)) throw overrun();
+                pos += count_size + count * scalarKindSize(prop.valueKind);
+
+                if (lists[pi])
+                    lists[pi]->offsets[ri + 1] = lists[pi]->offsets[ri] + count;
+            }
+
+            if (pos > data.size()) throw overrun();
+        }
+        counted();
+
+        return pos;
+    }
+
+    // 变长行的解码步骤: 先前进skip字节, 再处理属性pi (绑定的标量或任意列表), pi为npos表示行尾
+    // 相邻的未绑定标量合并进skip, 不产生任何步骤
+    struct RowStep {
+        size_t skip;
+        size_t pi;
+    };
+
+    std::vector<RowStep> rowSteps(const detail::ElementReadPlan& plan) {
+        const auto& props = plan.element->properties;
+
+        std::vector<RowStep> steps;
+        size_t skip = 0;
+        for (size_t pi = 0; pi < props.size(); ++pi) {
+            const bool scalar = props[pi].listKind == ScalarKind::UNUSED;
+            if (scalar && !plan.bindings[pi].copy) {
+                skip += scalarKindSize(props[pi].valueKind);
+                continue;
+            }
+
+            steps.push_back({ skip, pi });
+            skip = scalar ? scalarKindSize(props[pi].valueKind) : 0;
+        }
+        steps.push_back({ skip, std::string_view::npos });
+
+        return steps;
+    }
+
+    // 从内存逐行解码n行变长二进制行, [src, end) 为scanElementSize给出的区间
+    // 每行仍对照区间末尾与预先统计的CSR偏移检查, 数据与扫描结果不符 (如映射的文件被并发修改) 时抛出而不越界
+    void decodeRows(const detail::ElementReadPlan& plan, const std::byte* src, const std::byte* end, size_t r0, size_t n) {
+        const auto& elem = *plan.element;
+        const auto steps = rowSteps(plan);
+        const auto mismatch = [&elem]() {
+            return std::runtime_error(std::format("Ply Read Error: Data of element '{}' does not match its scanned layout.", elem.name));
+        };
+
+        for (size_t ri = r0; ri < r0 + n; ++ri) {
+            for (const auto& step : steps) {
+                if (step.skip > static_cast<size_t>(end - src)) throw mismatch();
+                src += step.skip;
+                if (step.pi == std::string_view::npos) break;
+
+                const auto& prop = elem.properties[step.pi];
+                const auto& b = plan.bindings[step.pi];
+
+                if (prop.listKind == ScalarKind::UNUSED) {
+                    if (scalarKindSize(prop.valueKind) > static_cast<size_t>(end - src)) throw mismatch();
+                    b.copy(src, 0, b.dst + ri * b.dstStride, 0, 1);
+                }
+                else {
+                    const size_t vsize = scalarKindSize(prop.valueKind);
+                    const size_t count_size = scalarKindSize(prop.listKind);
+                    if (count_size > static_cast<size_t>(end - src)) throw mismatch();
+                    const size_t count = loadListCount(src, prop.listKind);
+                    src += count_size;
+                    if (count > static_cast<size_t>(end - src) / vsize) throw mismatch();
+                    if (b.column && b.column->counted && b.column->offsets[ri + 1] - b.column->offsets[ri] != count) throw mismatch();
+                    if (b.assign || b.column) assignList(b, ri, src, count, vsize);
+                    src += count * vsize;
+                }
+            }
+        }
+
+        if (src != end) throw mismatch();
+    }
+
+    // 运行task(0..n-1), 由外部executor或临时线程并发执行
+    void parallelFor(const PlyReadOptions& options, size_t n, const std::function<void(size_t)>& task) {
+        if (options.executor) {
+            options.executor(n, task);
+            return;
+        }
+
+        const size_t threads = std::min<size_t>(n,
+            options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency()));
+
+        if (threads <= 1) {
+            for (size_t i = 0; i < n; ++i) task(i);
+            return;
+        }
+
+        std::atomic<size_t> next{ 0 };
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto worker = [&]() {
+            try {
+                for (size_t i; (i = next.fetch_add(1)) < n; ) task(i);
+            }
+            catch (...) {
+                std::lock_guard lock(error_mutex);
+                if (!error) error = std::current_exception();
+                next = n;
+            }
+        };
+
+        std::vector<std::jthread> pool;
+        for (size_t t = 1; t < threads; ++t) pool.emplace_back(worker);
+        worker();
+        pool.clear();
+
+        if (error) std::rethrow_exception(error);
+    }
+
+    size_t concurrency(const PlyReadOptions& options) {
+        if (options.executor || options.threads == 0) return std::max(1u, std::thread::hardware_concurrency());
+        return options.threads;
+    }
+
+    // 两遍并发扫描: 先统计各字节段的换行数, 前缀和得到各段的起始行号后再记录每step行的起始偏移
+    void buildLineIndex(std::string_view body, const PlyReadOptions& options, PlyLineIndex& index) {
+        constexpr size_t MIN_PART_SIZE = 1024 * 1024;
+
+        const size_t parts = std::clamp<size_t>(body.size() / MIN_PART_SIZE, 1, concurrency(options) * 4);
+        const size_t part_size = (body.size() + parts - 1) / parts;
+        const auto part = [&](size_t p) { return body.substr(std::min(p * part_size, body.size()), part_size); };
+
+        std::vector<size_t> first_line(parts + 1, 0);
+        parallelFor(parts > 1 ? options : PlyReadOptions{}, parts, [&](size_t p) {
+            const auto s = part(p);
+            first_line[p + 1] = static_cast<size_t>(std::count(s.begin(), s.end(), '\n'));
+        });
+        for (size_t p = 0; p < parts; ++p)
+            first_line[p + 1] += first_line[p];
+
+        index.lines = first_line[parts] + (!body.empty() && body.back() != '\n');
+        index.offsets.assign((index.lines + index.step - 1) / index.step, 0);
+
+        parallelFor(parts > 1 ? options : PlyReadOptions{}, parts, [&](size_t p) {
+            const auto s = part(p);
+            size_t line = first_line[p];
+            for (size_t at = s.find('\n'); at != std::string_view::npos; at = s.find('\n', at + 1)) {
+                if (++line % index.step == 0 && line < index.lines)
+                    index.offsets[line / index.step] = p * part_size + at + 1;
+            }
+        });
+    }
+
+    size_t locateLine(const PlyLineIndex& index, std::string_view body, size_t line) {
+        if (line >= index.lines) return body.size();
+
+        size_t pos = index.offsets[line / index.step];
+        for (size_t k = line % index.step; k > 0; --k)
+            pos = body.find('\n', pos) + 1;
+        return pos;
+    }
+
+    template <size_t Size>
+    void copyRows(const std::byte* src, size_t src_stride, std::byte* dst, size_t dst_stride, size_t count) {
+        size_t i = 0;
+
+#if TURBOPLY_SSE2
+        // 三角面片 (3个4字节索引) 写入连续的目标列: 每4行的12字节段由字节移位拼接为3个16字节写入
+        // 每行读取16字节, 只处理读取不越过最后一行末尾的行
+        if constexpr (Size == 12) {
+            if (dst_stride == 12 && src_stride >= 12) {
+                auto row = [&](size_t k) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + k * src_stride)); };
+                auto low12 = [](__m128i v) { return _mm_srli_si128(_mm_slli_si128(v, 4), 4); };
+
+                const size_t end = (count - 1) * src_stride + 12;
+                for (; i + 4 <= count && (i + 3) * src_stride + 16 <= end; i += 4) {
+                    const __m128i a = low12(row(i)), b = low12(row(i + 1)), c = low12(row(i + 2)), d = row(i + 3);
+                    __m128i* out = reinterpret_cast<__m128i*>(dst + i * 12);
+                    _mm_storeu_si128(out + 0, _mm_or_si128(a, _mm_slli_si128(b, 12)));
+                    _mm_storeu_si128(out + 1, _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+                    _mm_storeu_si128(out + 2, _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+                }
+            }
+        }
+#endif
+
+        for (; i < count; ++i)
+            std::memcpy(dst + i * dst_stride, src + i * src_stride, Size);
+    }
+
+    void copyRows(const std::byte* src, size_t src_stride, std::byte* dst, size_t dst_stride, size_t size, size_t count) {
+        if (size == src_stride && size == dst_stride) {
+            std::memcpy(dst, src, size * count);
+            return;
+        }
+
+        switch (size) {
+        case 4:  return copyRows<4>(src, src_stride, dst, dst_stride, count);
+        case 8:  return copyRows<8>(src, src_stride, dst, dst_stride, count);
+        case 12: return copyRows<12>(src, src_stride, dst, dst_stride, count);
+        case 16: return copyRows<16>(src, src_stride, dst, dst_stride, count);
+        }
+
+        for (size_t i = 0; i < count; ++i)
+            std::memcpy(dst + i * dst_stride, src + i * src_stride, size);
+    }
+
+    // 定长行的解码: 合并后的字节段整段拷贝, 其余列逐列转换
+    class FixedRowDecoder {
+    public:
+        explicit FixedRowDecoder(const detail::ElementReadPlan& plan) : _plan{ plan } {
+            splitColumnRuns(plan, _runs, _converts);
+        }
+
+        // src处的n行解码到目标的第r0行起
+        void operator()(const std::byte* src, size_t r0, size_t n) const {
+            const size_t stride = _plan.stride;
+            for (const auto& run : _runs)
+                copyRows(src + run.offset, stride, run.dst + r0 * run.dstStride, run.dstStride, run.size, n);
+
+            for (size_t pi : _converts) {
+                const auto& b = _plan.bindings[pi];
+                b.copy(src + _plan.offsets[pi], stride, b.dst + r0 * b.dstStride, b.dstStride, n);
+            }
+        }
+
+        // 目标列与文件行布局完全一致时返回目标内存, 可直接读入
+        std::byte* direct() const {
+            if (_converts.empty() && _runs.size() == 1 && _runs[0].size == _plan.stride && _runs[0].dstStride == _plan.stride)
+                return _runs[0].dst;
+            return nullptr;
+        }
+
+    private:
+        const detail::ElementReadPlan& _plan;
+        std::vector<ColumnRun> _runs;
+        std::vector<size_t> _converts;
+    };
+
+    inline void prefetchRow(const std::byte* p) {
+#if TURBOPLY_SSE2
+        _mm_prefetch(reinterpret_cast<const char*>(p), _MM_HINT_T0);
+#elif defined(__GNUC__)
+        __builtin_prefetch(p);
+#endif
+    }
+
+}
+
+detail::ElementReadPlan::ElementReadPlan(const PlyElement& elem)
+    : element{ &elem }, stride{ 0 }
+    , offsets(elem.properties.size()), bindings(elem.properties.size()) {
+    stride = rowLayout(elem, offsets);
+}
+
+detail::ElementWritePlan::ElementWritePlan(const PlyElement& elem)
+    : element{ &elem }, stride{ 0 }
+    , offsets(elem.properties.size()), sources(elem.properties.size()) {
+    stride = rowLayout(elem, offsets);
+}
+
+std::vector<size_t> PlySampling::sampleRows(size_t rows) const {
+    std::vector<size_t> selected;
+
+    if (!count) {
+        const size_t step = std::max<size_t>(stride, 1);
+        selected.reserve((rows + step - 1) / step);
+        for (size_t r = 0; r < rows; r += step)
+            selected.push_back(r);
+        return selected;
+    }
+
+    if (count >= rows) {
+        selected.resize(rows);
+        std::iota(selected.begin(), selected.end(), size_t{ 0 });
+        return selected;
+    }
+
+    // 每个count元子集被选中的概率相同: count远小于rows时用Floyd算法 (count次抽取后排序),
+    // 否则用Knuth的算法S顺序扫描一遍, 直接得到有序结果
+    std::mt19937_64 rng{ seed };
+    selected.reserve(count);
+
+    if (count <= rows / 16) {
+        std::unordered_set<size_t> chosen;
+        chosen.reserve(count);
+        for (size_t j = rows - count; j < rows; ++j) {
+            const size_t t = std::uniform_int_distribution<size_t>{ 0, j }(rng);
+            chosen.insert(chosen.contains(t) ? j : t);
+        }
+
+        selected.assign(chosen.begin(), chosen.end());
+        std::sort(selected.begin(), selected.end());
+        return selected;
+    }
+
+    // 第r行以 (尚缺的个数) / (剩余的行数) 的概率选中
+    for (size_t r = 0; selected.size() < count; ++r) {
+        if (std::uniform_int_distribution<size_t>{ 0, rows - r - 1 }(rng) < count - selected.size())
+            selected.push_back(r);
+    }
+    return selected;
+}
+
+void PlyBox::select(const float* x, const float* y, const float* z, size_t n, size_t first, std::vector<size_t>& selected) const {
+    size_t i = 0;
+
+#if TURBOPLY_SSE2
+    // 每次检查4个点, 通过的位由movemask取出
+    const __m128 lo[3] = { _mm_set1_ps(min[0]), _mm_set1_ps(min[1]), _mm_set1_ps(min[2]) };
+    const __m128 hi[3] = { _mm_set1_ps(max[0]), _mm_set1_ps(max[1]), _mm_set1_ps(max[2]) };
+    for (; i + 4 <= n; i += 4) {
+        const __m128 vx = _mm_loadu_ps(x + i), vy = _mm_loadu_ps(y + i), vz = _mm_loadu_ps(z + i);
+        __m128 in = _mm_and_ps(_mm_cmpge_ps(vx, lo[0]), _mm_cmple_ps(vx, hi[0]));
+        in = _mm_and_ps(in, _mm_and_ps(_mm_cmpge_ps(vy, lo[1]), _mm_cmple_ps(vy, hi[1])));
+        in = _mm_and_ps(in, _mm_and_ps(_mm_cmpge_ps(vz, lo[2]), _mm_cmple_ps(vz, hi[2])));
+
+        for (int mask = _mm_movemask_ps(in); mask; mask &= mask - 1)
+            selected.push_back(first + i + std::countr_zero(static_cast<unsigned>(mask)));
+    }
+#endif
+
+    for (; i < n; ++i) {
+        if (x[i] >= min[0] && x[i] <= max[0] && y[i] >= min[1] && y[i] <= max[1] && z[i] >= min[2] && z[i] <= max[2])
+            selected.push_back(first + i);
+    }
+}
+
+std::span<const std::byte> PlyStreamReader::elementMemory(const PlyElement& elem) {
+    parseHeader();
+
+    const auto* buf = dynamic_cast<const detail::MemoryStreamBuf*>(_is.rdbuf());
+    if (!buf || _body_offset < 0)
+        throw std::runtime_error("Ply Read Error: Element memory requires a memory-backed reader (enable file mapping).");
+
+    const size_t ei = static_cast<size_t>(&elem - _elements.data());
+    if (ei >= _elements.size())
+        throw std::runtime_error(std::format("Ply Read Error: Element '{}' does not belong to this reader.", elem.name));
+
+    auto memory = buf->memory();
+    if (_handler->isBinary()) {
+        // 只扫描到所需的元素为止
+        if (_element_offsets.empty())
+            _element_offsets.push_back(static_cast<size_t>(_body_offset));
+
+        while (_element_offsets.size() < ei + 2) {
+            const size_t offset = _element_offsets.back();
+            const auto& e = _elements[_element_offsets.size() - 1];
+            _element_offsets.push_back(offset + scanElementSize(fixedArity(e, memory.data() + offset), e, memory.subspan(offset)));
+        }
+    }
+    else if (_element_offsets.empty()) {
+        // ASCII: 每行一个元素行, 元素边界即行边界
+        const auto& index = lineIndex();
+        const auto body = memory.subspan(static_cast<size_t>(_body_offset));
+        const std::string_view text{ reinterpret_cast<const char*>(body.data()), body.size() };
+
+        size_t line = 0;
+        for (const auto& e : _elements) {
+            _element_offsets.push_back(static_cast<size_t>(_body_offset) + locateLine(index, text, line));
+            line += e.count;
+        }
+        _element_offsets.push_back(static_cast<size_t>(_body_offset) + locateLine(index, text, line));
+    }
+
+    return memory.subspan(_element_offsets[ei], _element_offsets[ei + 1] - _element_offsets[ei]);
+}
+
+// 元素的列表长度检查结果; 部分行的元素副本按数据地址找到所属元素, 找不到时返回nullptr (不缓存)
+detail::FixedArity* PlyStreamReader::fixedArity(const PlyElement& elem, const std::byte* data) {
+    if (_fixed_arity.size() != _elements.size()) {
+        _fixed_arity.assign(_elements.size(), detail::FixedArity{});
+        for (size_t ei = 0; ei < _elements.size(); ++ei)
+            _fixed_arity[ei].rows = _elements[ei].count;
+    }
+
+    if (const size_t ei = static_cast<size_t>(&elem - _elements.data()); ei < _elements.size())
+        return &_fixed_arity[ei];
+
+    const auto* buf = dynamic_cast<const detail::MemoryStreamBuf*>(_is.rdbuf());
+    if (!buf || data < buf->memory().data()) return nullptr;
+
+    const auto it = std::upper_bound(_element_offsets.begin(), _element_offsets.end(), static_cast<size_t>(data - buf->memory().data()));
+    if (it == _element_offsets.begin() || it == _element_offsets.end()) return nullptr;
+
+    const size_t ei = static_cast<size_t>(it - _element_offsets.begin()) - 1;
+    return _elements[ei].name == elem.name ? &_fixed_arity[ei] : nullptr;
+}
+
+void PlyStreamReader::seekRow(const PlyElement& elem, size_t row) {
+    parseHeader();
+
+    const size_t ei = static_cast<size_t>(&elem - _elements.data());
+    if (ei >= _elements.size())
+        throw std::runtime_error(std::format("Ply Read Error: Element '{}' does not belong to this reader.", elem.name));
+    if (row > elem.count)
+        throw std::runtime_error(std::format("Ply Read Error: Row {} is out of range for element '{}' with {} rows.", row, elem.name, elem.count));
+
+    _is.clear();
+    const detail::ElementReadPlan plan{ elem };
+    PlyElement skipped = elem;
+    skipped.count = row;
+
+    if (std::span<const std::byte> tail; peekMemory(tail)) {
+        elementMemory(elem);
+        if (!_handler->isBinary()) {
+            const auto memory = static_cast<const detail::MemoryStreamBuf*>(_is.rdbuf())->memory().subspan(static_cast<size_t>(_body_offset));
+            size_t line = row;
+            for (size_t e = 0; e < ei; ++e)
+                line += _elements[e].count;
+
+            _is.seekg(_body_offset + static_cast<std::streamoff>(
+                locateLine(_line_index, { reinterpret_cast<const char*>(memory.data()), memory.size() }, line)));
+            return;
+        }
+
+        _is.seekg(static_cast<std::streamoff>(_element_offsets[ei] + row * plan.stride));
+        if (!plan.stride) skipElement(detail::ElementReadPlan{ skipped });
+        return;
+    }
+
+    if (_body_offset < 0 || !_is.seekg(_body_offset))
+        throw std::runtime_error("Ply Read Error: Row access requires a seekable stream.");
+
+    for (size_t e = 0; e < ei; ++e)
+        skipElement(detail::ElementReadPlan{ _elements[e] });
+    skipElement(detail::ElementReadPlan{ skipped });
+}
+
+void PlyStreamReader::readElement(const detail::ElementReadPlan& plan, const PlyReadOptions& options) {
+    if (std::none_of(plan.bindings.begin(), plan.bindings.end(), [](const auto& b) { return b.copy; }))
+        skipElement(plan);
+    else if (!_handler->isBinary())
+        readAsciiRows(plan, options);
+    else if (plan.stride)
+        readFixedRows(plan, options);
+    else if (!readFixedArityRows(plan, options))
+        readVariableRows(plan, options);
+}
+
+void PlyStreamReader::readBytes(std::byte* dst, size_t n, const PlyElement& elem) {
+    if (!_is.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(n)))
+        throw std::runtime_error(std::format("Ply Read Error: Unexpected end of data in element '{}'.", elem.name));
+}
+
+void PlyStreamReader::skipBytes(size_t n, const PlyElement& elem) {
+    if (n && (!_is.ignore(static_cast<std::streamsize>(n)) || _is.gcount() != static_cast<std::streamsize>(n)))
+        throw std::runtime_error(std::format("Ply Read Error: Unexpected end of data in element '{}'.", elem.name));
+}
+
+// 未绑定的元素: 内存流与定长行直接跳过, 变长行只读取列表长度, ASCII逐行跳过
+void PlyStreamReader::skipElement(const detail::ElementReadPlan& plan) {
+    const auto& elem = *plan.element;
+
+    if (!_handler->isBinary()) {
+        readAsciiRows(plan, PlyReadOptions{});
+        return;
+    }
+
+    if (std::span<const std::byte> tail; peekMemory(tail)) {
+        _is.seekg(static_cast<std::streamoff>(scanElementSize(fixedArity(elem, tail.data()), elem, tail)), std::ios_base::cur);
+        return;
+    }
+
+    if (plan.stride) {
+        // 不可定位的流退回到逐块丢弃
+        if (!_is.seekg(static_cast<std::streamoff>(elem.count * plan.stride), std::ios_base::cur)) {
+            _is.clear();
+            skipBytes(elem.count * plan.stride, elem);
+        }
+        return;
+    }
+
+    std::byte count[8];
+    size_t pending = 0;
+    for (size_t ri = 0; ri < elem.count; ++ri) {
+        for (const auto& prop : elem.properties) {
+            if (prop.listKind == ScalarKind::UNUSED) {
+                pending += scalarKindSize(prop.valueKind);
+                continue;
+            }
+
+            skipBytes(pending, elem);
+            readBytes(count, scalarKindSize(prop.listKind), elem);
+            pending = loadListCount(count, prop.listKind) * scalarKindSize(prop.valueKind);
+        }
+    }
+    skipBytes(pending, elem);
+}
+
+// 内存流取得当前位置之后的全部字节 (调用方处理后自行seekg)
+bool PlyStreamReader::peekMemory(std::span<const std::byte>& tail) {
+    const auto* buf = dynamic_cast<const detail::MemoryStreamBuf*>(_is.rdbuf());
+    if (!buf) return false;
+
+    const auto memory = buf->memory();
+    const auto pos = _is.tellg();
+    if (pos < 0 || static_cast<size_t>(pos) > memory.size()) return false;
+
+    tail = memory.subspan(static_cast<size_t>(pos));
+    return true;
+}
+
+void PlyStreamReader::readFixedRows(const detail::ElementReadPlan& plan, const PlyReadOptions& options) {
+    constexpr size_t BLOCK_SIZE = 1024 * 1024;
+    constexpr size_t MIN_CHUNK_SIZE = 256 * 1024;
+
+    const auto& elem = *plan.element;
+    const size_t stride = plan.stride;
+    const FixedRowDecoder decode{ plan };
+
+    // 将[r0, r0 + n)切分为行区间并发解码
+    const size_t workers = concurrency(options);
+    const size_t min_chunk_rows = std::max<size_t>(1, MIN_CHUNK_SIZE / stride);
+    auto decodeParallel = [&](const std::byte* src, size_t r0, size_t n) {
+        const size_t chunk_rows = std::max(min_chunk_rows, (n + workers * 4 - 1) / (workers * 4));
+        const size_t chunks = (n + chunk_rows - 1) / chunk_rows;
+
+        parallelFor(chunks > 1 ? options : PlyReadOptions{}, chunks, [&](size_t ci) {
+            const size_t first = ci * chunk_rows;
+            decode(src + first * stride, r0 + first, std::min(chunk_rows, n - first));
+        });
+    };
+
+    const size_t bytes = elem.count * stride;
+    if (std::span<const std::byte> tail; peekMemory(tail)) {
+        if (tail.size() < bytes)
+            throw std::runtime_error(std::format("Ply Read Error: Unexpected end of data in element '{}'.", elem.name));
+
+        decodeParallel(tail.data(), 0, elem.count);
+        _is.seekg(static_cast<std::streamoff>(bytes), std::ios_base::cur);
+        return;
+    }
+
+    // 目标列与文件行布局完全一致时直接读入目标内存
+    if (std::byte* dst = decode.direct()) {
+        readBytes(dst, bytes, elem);
+        return;
+    }
+
+    const size_t block_rows = std::max<size_t>(1, BLOCK_SIZE * workers / stride);
+    ColumnVector<std::byte> block(std::min(block_rows, elem.count) * stride);
+
+    for (size_t r0 = 0; r0 < elem.count; r0 += block_rows) {
+        const size_t n = std::min(block_rows, elem.count - r0);
+        readBytes(block.data(), n * stride, elem);
+        decodeParallel(block.data(), r0, n);
+    }
+}
+
+void PlyStreamReader::readRows(const detail::ElementReadPlan& plan, std::span<const size_t> rows, const PlyReadOptions& options) {
+    readRows(plan, rows, {}, options);
+}
+
+// 行号排序后按文件顺序访问: 映射内存直接解码并预取后续行, 流中相近的行合并为一次块读取
+// 非定长的行 (ASCII, 长度不定的列表) 逐段定位后交由readElement解码
+void PlyStreamReader::readRows(const detail::ElementReadPlan& plan, std::span<const size_t> rows, std::span<const size_t> targets, const PlyReadOptions& options) {
+    constexpr size_t MAX_GAP = 64 * 1024;       // 间隔不超过此字节数的行合并读取
+    constexpr size_t BLOCK_SIZE = 1024 * 1024;
+    constexpr size_t PREFETCH_ROWS = 8;
+    constexpr size_t MIN_CHUNK_ROWS = 4 * 1024;
+
+    parseHeader();
+
+    const auto& elem = *plan.element;
+    const size_t ei = static_cast<size_t>(&elem - _elements.data());
+    if (ei >= _elements.size())
+        throw std::runtime_error(std::format("Ply Read Error: Element '{}' does not belong to this reader.", elem.name));
+    for (size_t row : rows) {
+        if (row >= elem.count)
+            throw std::runtime_error(std::format("Ply Read Error: Row {} is out of range for element '{}' with {} rows.", row, elem.name, elem.count));
+    }
+    if (!targets.empty() && targets.size() != rows.size())
+        throw std::runtime_error(std::format("Ply Read Error: {} target rows given for {} rows of element '{}'.", targets.size(), rows.size(), elem.name));
+    if (hasListColumns(plan))
+        throw std::runtime_error(std::format("Ply Read Error: CSR list properties of element '{}' cannot be read by row selection.", elem.name));
+    if (rows.empty()) return;
+
+    // 按文件行号排序: src[k]为第k小的行号, out[k]为它的输出行
+    std::vector<size_t> src(rows.size()), out(rows.size());
+    std::iota(out.begin(), out.end(), size_t{ 0 });
+    if (!std::is_sorted(rows.begin(), rows.end()))
+        std::stable_sort(out.begin(), out.end(), [&](size_t a, size_t b) { return rows[a] < rows[b]; });
+    for (size_t k = 0; k < rows.size(); ++k) {
+        src[k] = rows[out[k]];
+        if (!targets.empty()) out[k] = targets[out[k]];
+    }
+
+    // [k, end)中文件行与输出行都相邻的一段的长度
+    auto runLength = [&](size_t k, size_t end) {
+        size_t n = 1;
+        while (k + n < end && src[k + n] == src[k] + n && out[k + n] == out[k] + n) ++n;
+        return n;
+    };
+
+    std::span<const std::byte> memory;
+    PlyElement fixed;
+    std::optional<detail::ElementReadPlan> fixed_plan;
+    const detail::ElementReadPlan* row_plan = &plan;
+
+    std::span<const std::byte> tail;
+    const bool mapped = peekMemory(tail);
+    if (_handler->isBinary() && mapped) {
+        memory = elementMemory(elem);
+        if (!plan.stride && (fixed_plan = fixedArityPlan(fixedArity(elem, memory.data()), plan, memory, fixed)))
+            row_plan = &*fixed_plan;
+    }
+
+    const size_t stride = row_plan->stride;
+    if (_handler->isBinary() && stride) {
+        const FixedRowDecoder decode{ *row_plan };
+
+        // 内存: 按排序后的行号切分为区间并发解码
+        if (mapped) {
+            if (memory.size() < elem.count * stride)
+                throw std::runtime_error(std::format("Ply Read Error: Unexpected end of data in element '{}'.", elem.name));
+
+            const size_t workers = concurrency(options);
+            const size_t chunk_rows = std::max(MIN_CHUNK_ROWS, (rows.size() + workers * 4 - 1) / (workers * 4));
+            const size_t chunks = (rows.size() + chunk_rows - 1) / chunk_rows;
+
+            parallelFor(chunks > 1 ? options : PlyReadOptions{}, chunks, [&](size_t ci) {
+                const size_t end = std::min(rows.size(), (ci + 1) * chunk_rows);
+                for (size_t k = ci * chunk_rows; k < end;) {
+                    if (k + PREFETCH_ROWS < end)
+                        prefetchRow(memory.data() + src[k + PREFETCH_ROWS] * stride);
+
+                    const size_t n = runLength(k, end);
+                    decode(memory.data() + src[k] * stride, out[k], n);
+                    k += n;
+                }
+            });
+            return;
+        }
+
+        seekRow(elem, 0);
+        const auto start = _is.tellg();
+        ColumnVector<std::byte> block;
+
+        for (size_t k = 0; k < rows.size();) {
+            const size_t lo = src[k];
+            size_t end = k + 1;
+            while (end < rows.size() && (src[end] - src[end - 1]) * stride <= MAX_GAP
+                && (src[end] - lo + 1) * stride <= BLOCK_SIZE) ++end;
+
+            const size_t bytes = (src[end - 1] - lo + 1) * stride;
+            block.resize(bytes);
+            _is.seekg(start + static_cast<std::streamoff>(lo * stride));
+            readBytes(block.data(), bytes, elem);
+
+            while (k < end) {
+                const size_t n = runLength(k, end);
+                decode(block.data() + (src[k] - lo) * stride, out[k], n);
+                k += n;
+            }
+        }
+        return;
+    }
+
+    // 一般路径: 逐段解码到输出位置, 段间的行ASCII内存流经行索引定位, 其余逐行跳过
+    detail::ElementReadPlan part = plan;
+    PlyElement sub = elem;
+    part.element = &sub;
+
+    size_t pos = src[0];
+    seekRow(elem, pos);
+    for (size_t k = 0; k < rows.size();) {
+        const size_t row = src[k];
+        if (row < pos) {
+            seekRow(elem, row); // 重复的行
+        }
+        else if (row > pos) {
+            if (mapped && !_handler->isBinary()) {
+                seekRow(elem, row);
+            }
+            else {
+                sub.count = row - pos;
+                skipElement(detail::ElementReadPlan{ sub });
+            }
+        }
+
+        const size_t n = runLength(k, rows.size());
+        sub.count = n;
+        for (size_t pi = 0; pi < part.bindings.size(); ++pi) {
+            if (plan.bindings[pi].dst)
+                part.bindings[pi].dst = plan.bindings[pi].dst + out[k] * plan.bindings[pi].dstStride;
+        }
+        readElement(part);
+
+        pos = row + n;
+        k += n;
+    }
+}
+
+// 列表长度恒定的变长元素 (如三角面片) 展开为定长行读取, 可并发解码
+// 仅用于内存流; 任一行的长度不同, 或绑定的定长容器长度不符时返回false, 交由一般路径处理
+bool PlyStreamReader::readFixedArityRows(const detail::ElementReadPlan& plan, const PlyReadOptions& options) {
+    std::span<const std::byte> tail;
+    if (!peekMemory(tail)) return false;
+
+    PlyElement fixed;
+    const auto fixed_plan = fixedArityPlan(fixedArity(*plan.element, tail.data()), plan, tail, fixed);
+    if (!fixed_plan) return false;
+
+    readFixedRows(*fixed_plan, options);
+    return true;
+}
+
+void PlyStreamReader::readVariableRows(const detail::ElementReadPlan& plan, const PlyReadOptions& options) {
+    constexpr size_t MIN_CHUNK_ROWS = 16 * 1024;
+
+    const auto& elem = *plan.element;
+    const auto& props = elem.properties;
+
+    // 内存流: 先只扫描列表长度得到各行区间的起始偏移, 再并发解码各区间
+    if (std::span<const std::byte> tail; peekMemory(tail)) {
+        const size_t workers = concurrency(options);
+        const size_t chunk_rows = std::max(MIN_CHUNK_ROWS, (elem.count + workers * 4 - 1) / (workers * 4));
+
+        // CSR列在扫描时得到全部偏移并一次分配值区, 各区间再并发写入各自的值段
+        std::vector<size_t> chunk_offsets;
+        const size_t bytes = scanElementSize(fixedArity(elem, tail.data()), elem, tail, chunk_rows, &chunk_offsets, &plan);
+
+        parallelFor(chunk_offsets.size() > 1 ? options : PlyReadOptions{}, chunk_offsets.size(), [&](size_t ci) {
+            const size_t first = ci * chunk_rows;
+            const size_t last = ci + 1 < chunk_offsets.size() ? chunk_offsets[ci + 1] : bytes;
+            decodeRows(plan, tail.data() + chunk_offsets[ci], tail.data() + last, first, std::min(chunk_rows, elem.count - first));
+        });
+
+        _is.seekg(static_cast<std::streamoff>(bytes), std::ios_base::cur);
+        return;
+    }
+
+    // 每行先按文件类型读入row缓冲 (连续标量段整块读取), 再按绑定写入目标列
+    std::vector<std::byte> row(256);
+    std::vector<size_t> pos(props.size()), len(props.size());
+    size_t used = 0, pending = 0;
+
+    auto take = [&](size_t n) {
+        if (used + n > row.size())
+            row.resize(std::max(row.size() * 2, used + n));
+        used += n;
+        return used - n;
+    };
+    auto fetch = [&](size_t at, size_t n, ScalarKind k) {
+        readBytes(row.data() + at, n * scalarKindSize(k), elem);
+    };
+    auto flush = [&]() {
+        if (pending) readBytes(row.data() + used - pending, pending, elem);
+        pending = 0;
+    };
+
+    for (size_t ri = 0; ri < elem.count; ++ri) {
+        used = 0;
+
+        for (size_t pi = 0; pi < props.size(); ++pi) {
+            const auto& prop = props[pi];
+            const size_t vsize = scalarKindSize(prop.valueKind);
+
+            if (prop.listKind == ScalarKind::UNUSED) {
+                pos[pi] = take(vsize);
+                len[pi] = 1;
+                pending += vsize;
+            }
+            else {
+                flush();
+                size_t at = take(scalarKindSize(prop.listKind));
+                fetch(at, 1, prop.listKind);
+                len[pi] = loadListCount(row.data() + at, prop.listKind);
+
+                // 值分段读入: 长度与数据不符时在读到末尾处报错, 而不是先按长度分配
+                pos[pi] = used;
+                for (size_t left = len[pi] * vsize; left; ) {
+                    const size_t n = std::min<size_t>(left, 1024 * 1024);
+                    at = take(n);
+                    readBytes(row.data() + at, n, elem);
+                    left -= n;
+                }
+            }
+        }
+        flush();
+
+        for (size_t pi = 0; pi < props.size(); ++pi) {
+            const auto& b = plan.bindings[pi];
+            if (b.assign || b.column)
+                assignList(b, ri, row.data() + pos[pi], len[pi], scalarKindSize(props[pi].valueKind));
+            else if (b.copy)
+                b.copy(row.data() + pos[pi], 0, b.dst + ri * b.dstStride, 0, 1);
+        }
+    }
+}
+
+// ASCII: 内存流直接在映射区间上扫描, 否则逐行读入后扫描
+const PlyLineIndex& PlyStreamReader::lineIndex(const PlyReadOptions& options) {
+    parseHeader();
+
+    const auto* buf = dynamic_cast<const detail::MemoryStreamBuf*>(_is.rdbuf());
+    if (!buf || _body_offset < 0)
+        throw std::runtime_error("Ply Read Error: Line index requires a memory-backed reader (enable file mapping).");
+    if (_handler->isBinary())
+        throw std::runtime_error("Ply Read Error: Line index is only available for ASCII PLY files.");
+
+    if (_line_index.offsets.empty()) {
+        const auto body = buf->memory().subspan(static_cast<size_t>(_body_offset));
+        buildLineIndex({ reinterpret_cast<const char*>(body.data()), body.size() }, options, _line_index);
+    }
+
+    return _line_index;
+}
+
+void PlyStreamReader::readAsciiRows(const detail::ElementReadPlan& plan, const PlyReadOptions& options) {
+    constexpr size_t MIN_CHUNK_ROWS = 16 * 1024;
+
+    const auto& elem = *plan.element;
+    const size_t ei = static_cast<size_t>(plan.element - _elements.data());
+    const size_t workers = concurrency(options);
+
+    // 内存流多线程: 每行一个元素行, 由行索引定位各段的起始行, 各段并发解析到对应的全局行号
+    // CSR列表列的值逐行接续, 只能顺序解析
+    if (std::span<const std::byte> tail; workers > 1 && ei < _elements.size() && elem.count > MIN_CHUNK_ROWS && !hasListColumns(plan) && peekMemory(tail)) {
+        const auto& index = lineIndex(options);
+        const auto memory = static_cast<const detail::MemoryStreamBuf*>(_is.rdbuf())->memory().subspan(static_cast<size_t>(_body_offset));
+        const std::string_view body{ reinterpret_cast<const char*>(memory.data()), memory.size() };
+
+        size_t first_line = 0;
+        for (size_t e = 0; e < ei; ++e)
+            first_line += _elements[e].count;
+
+        const size_t chunk_rows = std::max(MIN_CHUNK_ROWS, (elem.count + workers * 4 - 1) / (workers * 4));
+        const size_t chunks = (elem.count + chunk_rows - 1) / chunk_rows;
+
+        std::vector<size_t> bounds(chunks + 1);
+        for (size_t ci = 0; ci <= chunks; ++ci)
+            bounds[ci] = locateLine(index, body, first_line + std::min(ci * chunk_rows, elem.count));
+
+        parallelFor(options, chunks, [&](size_t ci) {
+            const size_t first = ci * chunk_rows;
+            AsciiScanner scanner{ body.data() + bounds[ci], body.data() + bounds[ci + 1] };
+            decodeAsciiRows(plan, scanner, first, std::min(chunk_rows, elem.count - first));
+        });
+
+        _is.seekg(_body_offset + static_cast<std::streamoff>(bounds[chunks]));
+        return;
+    }
+
+    if (std::span<const std::byte> tail; peekMemory(tail)) {
+        const char* begin = reinterpret_cast<const char*>(tail.data());
+        AsciiScanner scanner{ begin, begin + tail.size() };
+        decodeAsciiRows(plan, scanner, 0, plan.element->count);
+
+        _is.seekg(static_cast<std::streamoff>(scanner.position() - begin), std::ios_base::cur);
+        return;
+    }
+
+    AsciiScanner scanner{ _is };
+    decodeAsciiRows(plan, scanner, 0, plan.element->count);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 void PlyStreamWriter::addComment(std::string c) {
     _comments.push_back(std::move(c));
 }
@@ -309,5 +1653,117 @@ void PlyStreamWriter::writeLineEnd() {
     _handler->writeLineEnd(_os);
 }
 
+void PlyStreamWriter::writeElement(const detail::ElementWritePlan& plan) {
+    constexpr size_t BLOCK_SIZE = 1024 * 1024;
+
+    const auto& elem = *plan.element;
+    const auto& props = elem.properties;
+    const bool binary = _handler->isBinary();
+
+    for (size_t pi = 0; pi < props.size(); ++pi) {
+        const auto& s = plan.sources[pi];
+        if ((elem.count && !s.src && !s.offsets) || (props[pi].listKind != ScalarKind::UNUSED) != (s.view || s.offsets))
+            throw std::runtime_error(std::format(
+                "Ply Write Error: Property '{}' of element '{}' has no matching source column.", props[pi].name, elem.name));
+    }
+
+    // 源列写入count行的目标列: 类型与文件一致时按字节拷贝
+    auto column = [&](size_t pi, const std::byte* src, std::byte* dst, size_t dst_stride, size_t count) {
+        const auto& s = plan.sources[pi];
+        if (s.copy)
+            s.copy(src, s.srcStride, dst, dst_stride, count);
+        else
+            copyRows(src, s.srcStride, dst, dst_stride, scalarKindSize(props[pi].valueKind), count);
+    };
+
+    // 定长二进制行写入内存 (内存写入器, 文件映射): 直接逐列转换到目标缓冲
+    auto* memory = binary && plan.stride && elem.count ? dynamic_cast<detail::MemoryStreamBuf*>(_os.rdbuf()) : nullptr;
+    if (auto dst = memory ? memory->reserve(elem.count * plan.stride) : std::span<std::byte>{}; !dst.empty()) {
+        for (size_t pi = 0; pi < props.size(); ++pi)
+            column(pi, plan.sources[pi].src, dst.data() + plan.offsets[pi], plan.stride, elem.count);
+        memory->commit(dst.size());
+        return;
+    }
+
+    // 定长二进制行: 按块逐列转换到文件行布局, 整块写出
+    if (binary && plan.stride) {
+        const size_t block_rows = std::max<size_t>(1, BLOCK_SIZE / plan.stride);
+        ColumnVector<std::byte> block(std::min(block_rows, elem.count) * plan.stride);
+
+        for (size_t r0 = 0; r0 < elem.count; r0 += block_rows) {
+            const size_t n = std::min(block_rows, elem.count - r0);
+            for (size_t pi = 0; pi < props.size(); ++pi) {
+                const auto& s = plan.sources[pi];
+                column(pi, s.src + r0 * s.srcStride, block.data() + plan.offsets[pi], plan.stride, n);
+            }
+            _os.write(reinterpret_cast<const char*>(block.data()), n * plan.stride);
+        }
+        return;
+    }
+
+    // 变长行或ASCII: 逐行编码到缓冲, 攒满一块再写出
+    std::vector<char> out;
+    std::vector<std::byte> values;
+    std::byte value[8];
+    out.reserve(BLOCK_SIZE + 4096);
+
+    auto put = [&](const std::byte* p, size_t n, ScalarKind k) {
+        const size_t size = scalarKindSize(k);
+        if (binary) {
+            out.insert(out.end(), reinterpret_cast<const char*>(p), reinterpret_cast<const char*>(p + n * size));
+        }
+        else {
+            for (size_t i = 0; i < n; ++i)
+                formatScalar(out, p + i * size, k);
+        }
+    };
+
+    for (size_t ri = 0; ri < elem.count; ++ri) {
+        for (size_t pi = 0; pi < props.size(); ++pi) {
+            const auto& prop = props[pi];
+            const auto& s = plan.sources[pi];
+            const std::byte* item = s.src + ri * s.srcStride;
+
+            if (!s.view && !s.offsets) {
+                if (s.copy) s.copy(item, 0, value, 0, 1);
+                put(s.copy ? value : item, 1, prop.valueKind);
+                continue;
+            }
+
+            const std::byte* src = nullptr;
+            size_t n = 0;
+            if (s.offsets) {
+                src = s.src + s.offsets[ri] * s.valueSize;
+                n = static_cast<size_t>(s.offsets[ri + 1] - s.offsets[ri]);
+            }
+            else {
+                n = s.view(item, src);
+            }
+            storeListCount(value, n, prop.listKind);
+            put(value, 1, prop.listKind);
+
+            if (!s.copy) {
+                put(src, n, prop.valueKind);
+                continue;
+            }
+
+            values.resize(n * scalarKindSize(prop.valueKind));
+            s.copy(src, s.valueSize, values.data(), scalarKindSize(prop.valueKind), n);
+            put(values.data(), n, prop.valueKind);
+        }
+
+        // 行尾空格替换为换行, 同AsciiHandler::writeLineEnd
+        if (!binary && !out.empty())
+            out.back() = '\n';
+
+        if (out.size() >= BLOCK_SIZE) {
+            _os.write(out.data(), out.size());
+            out.clear();
+        }
+    }
+
+    _os.write(out.data(), out.size());
+}
+
 }
 
@@ -48,12 +48,18 @@
 
 #define TURBOPLY_ENABLE_FILE_MAPPING 1
 
+#include <span>
+#include <array>
 #include <string>
 #include <vector>
+#include <cstddef>
+#include <streambuf>
+#include <functional>
 #include <variant>
 #include <sstream>
 #include <fstream>
 #include <filesystem>
+#include <thread>
 
 namespace turboply {
 
@@ -64,6 +70,11 @@ enum class ScalarKind : uint8_t { UNUSED, INT8, UINT8, INT16, UINT16, INT32, UIN
 template <typename T> 
 T ply_cast(const PlyScalar& v) { return std::visit([](auto&& x) { return static_cast<T>(x); }, v); }
 
+constexpr size_t scalarKindSize(ScalarKind k) {
+    constexpr size_t sizes[] = { 0, 1, 1, 2, 2, 4, 4, 4, 8 };
+    return sizes[static_cast<int>(k)];
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 class PlyBase {
@@ -102,6 +113,175 @@ using PlyElement = PlyBase::Element;
 
 //////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+    // 将count个文件类型的标量 (步长src_stride) 转换写入目标列 (步长dst_stride)
+    using ColumnCopyFn = void(*)(const std::byte* src, size_t src_stride, std::byte* dst, size_t dst_stride, size_t count);
+    // 将n个文件类型的列表值 (每个src_size字节) 经copy转换写入item处的列表容器
+    using ListAssignFn = void(*)(std::byte* item, const std::byte* src, size_t n, size_t src_size, ColumnCopyFn copy);
+    // 返回item处列表容器的长度, values指向其连续存储的值
+    using ListViewFn = size_t(*)(const std::byte* item, const std::byte*& values);
+
+    // Batch conversion kernel between two scalar kinds, SIMD accelerated for the common pairs.
+    // With saturate, out-of-range values clamp to the destination range (NaN becomes 0 for integer destinations,
+    // stays NaN for float). Without it, integer narrowing wraps and out-of-range float to integer is undefined.
+    ColumnCopyFn convertKernel(ScalarKind src, ScalarKind dst, bool saturate = false);
+
+    // List property stored flat (CSR): the values of row ri are values[offsets[ri], offsets[ri + 1]).
+    // offsets has count + 1 entries with offsets[0] = 0; reserve grows the value storage.
+    struct ListColumn {
+        uint64_t* offsets = nullptr;
+        std::byte* values = nullptr;
+        size_t capacity = 0;            // values
+        size_t valueSize = 0;
+        bool counted = false;           // offsets already hold the prefix sum of all list lengths
+        void* owner = nullptr;
+        void (*reserve)(ListColumn& column, size_t n) = nullptr;   // capacity of at least n values
+    };
+
+    struct PropertyBinding {
+        std::byte* dst = nullptr;       // field address in row 0 of the bound column, nullptr if unbound
+        size_t dstStride = 0;
+        ScalarKind dstKind = ScalarKind::UNUSED;
+        ColumnCopyFn copy = nullptr;    // scalar property, or value conversion of a list property
+        ListAssignFn assign = nullptr;  // list property
+        size_t arity = 0;               // length of a fixed-size list container (std::array), 0 if resizable
+        ListColumn* column = nullptr;   // list property read as CSR instead of assign, rows appended in order
+    };
+
+    // Compiled once per element from the parsed header and the bound specs.
+    struct ElementReadPlan {
+        explicit ElementReadPlan(const PlyElement& elem);
+
+        const PlyElement* element;
+        size_t stride;                          // binary row size, 0 if the element has list properties
+        std::vector<size_t> offsets;            // property byte offsets inside a fixed-stride row
+        std::vector<PropertyBinding> bindings;  // one per file property
+    };
+
+    // List length check over all rows of one element, done once and reused by later reads of any of its rows.
+    struct FixedArity {
+        size_t rows = 0;                        // rows of the element
+        bool checked = false;
+        size_t stride = 0;                      // expanded row size, 0 if the list lengths are not constant
+        std::vector<size_t> arity;              // list length per property, 0 for scalars
+    };
+
+    struct PropertySource {
+        const std::byte* src = nullptr; // field address in row 0 of the source column
+        size_t srcStride = 0;
+        size_t valueSize = 0;           // size of one source value
+        ColumnCopyFn copy = nullptr;    // source kind to file kind, per value for lists; nullptr when they match (bitwise copy)
+        ListViewFn view = nullptr;      // list property
+        const uint64_t* offsets = nullptr;  // list property stored as CSR: src holds the flat values
+    };
+
+    struct ElementWritePlan {
+        explicit ElementWritePlan(const PlyElement& elem);
+
+        const PlyElement* element;
+        size_t stride;
+        std::vector<size_t> offsets;
+        std::vector<PropertySource> sources;    // one per file property, all must be set
+    };
+
+    // Faults the pages of freshly allocated output columns in a background thread, without changing
+    // their contents, while the decoder fills them. Stops and joins on destruction.
+    class PagePrefault {
+    public:
+        explicit PagePrefault(std::vector<std::span<std::byte>> ranges);
+
+    private:
+        std::jthread _thread;
+    };
+
+    // streambuf whose whole content is addressable memory (file mapping, in-memory buffers)
+    class MemoryStreamBuf : public std::streambuf {
+    public:
+        std::span<const std::byte> memory() const {
+            return { reinterpret_cast<const std::byte*>(eback()), static_cast<size_t>(egptr() - eback()) };
+        }
+
+        // n writable bytes at the put position, empty if the buffer cannot hold them; commit() advances past them.
+        virtual std::span<std::byte> reserve(size_t n) {
+            if (static_cast<size_t>(epptr() - pptr()) < n) return {};
+            return { reinterpret_cast<std::byte*>(pptr()), n };
+        }
+        void commit(size_t n);
+
+    protected:
+        virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+            std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
+        virtual pos_type seekpos(pos_type sp, 
+            std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
+    };
+
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+// Decimation of one element on read: every stride-th row, or count rows chosen uniformly at random
+// (reproducible for a seed, kept in file order). Rows that are not selected are not decoded.
+struct PlySampling {
+    size_t stride = 1;
+    size_t count = 0;               // random selection when non-zero, overrides stride
+    uint64_t seed = 0;
+    std::string element = "vertex"; // sampled element, empty samples every element
+
+    bool enabled() const { return count || stride > 1; }
+    // Sorted row numbers selected from an element with the given number of rows.
+    std::vector<size_t> sampleRows(size_t rows) const;
+};
+
+// Axis-aligned box, bounds inclusive.
+struct PlyBox {
+    std::array<float, 3> min{};
+    std::array<float, 3> max{};
+    // Names used by bind_box_reader: the tested coordinates and the face list remapped to the kept vertices.
+    std::string vertexElement = "vertex";
+    std::array<std::string, 3> coordinates{ "x", "y", "z" };
+    std::string faceElement = "face";
+    std::string indexProperty = "vertex_indices";
+
+    // Appends first + i for every point i < n inside the box, coordinates given as separate columns.
+    void select(const float* x, const float* y, const float* z, size_t n, size_t first, std::vector<size_t>& selected) const;
+};
+
+struct PlyReadOptions {
+    // Threads decoding an element concurrently, 0 selects std::thread::hardware_concurrency().
+    unsigned threads = 1;
+    // Optional external executor. It must run task(i) for every i in [0, n) and return when all are done.
+    std::function<void(size_t n, const std::function<void(size_t)>& task)> executor;
+    // Clamp narrowing conversions (e.g. double to float, int to uchar, float to int) to the destination range.
+    // Without it, integer narrowing wraps modulo 2^N, double to float overflows to infinity, and out-of-range
+    // float to integer conversions are undefined behaviour.
+    bool saturate = false;
+    // Used by bind_reader; the reader must be memory-backed or seekable when it is enabled.
+    PlySampling sampling;
+};
+
+// Progressive loading: the first pass decodes every coarseStride-th row, each further pass divides the
+// stride by factor until every row is loaded. A row is decoded in exactly one pass.
+struct PlyProgressiveOptions {
+    size_t coarseStride = 256;
+    size_t factor = 4;
+};
+
+struct PlyBatchOptions {
+    size_t batchRows = 64 * 1024;
+    // Upper bound in bytes of all batch buffers together (row structs only, not list contents), 0 for no bound.
+    size_t memoryLimit = 0;
+    // Threads consuming batches concurrently, 0 runs the callback on the reading thread.
+    unsigned workers = 0;
+};
+
+// Sparse line index of an ASCII body: offsets[i] is the byte offset, from the first body line, of line i * step.
+struct PlyLineIndex {
+    size_t step = 1024;
+    size_t lines = 0;
+    std::vector<size_t> offsets;
+};
+
 class PlyStreamReader : public PlyBase {
 public:
     using StreamT = std::istream;
@@ -116,9 +296,39 @@ public:
     const std::vector<PlyElement>& getElements() const;
 
     PlyScalar readScalar(ScalarKind );
+    // Decodes the next plan.element->count rows at the current position, so a copy of an element
+    // with a smaller count reads the element batch by batch.
+    void readElement(const detail::ElementReadPlan& plan, const PlyReadOptions& options = {});
+
+    // Raw binary rows (ASCII: text lines) of an element inside a memory-backed stream, valid for the reader's lifetime.
+    std::span<const std::byte> elementMemory(const PlyElement& elem);
+    // Built on first use for memory-backed ASCII readers, one element row per line.
+    const PlyLineIndex& lineIndex(const PlyReadOptions& options = {});
+    // Positions the stream at a row of an element. Direct for memory-backed readers and fixed-stride binary
+    // elements; otherwise earlier rows are skipped. Plain streams must be seekable.
+    void seekRow(const PlyElement& elem, size_t row);
+    // Gathers rows of an element in any order (duplicates allowed): output row i receives row rows[i].
+    // The plan's element must belong to this reader; the stream position afterwards is unspecified.
+    void readRows(const detail::ElementReadPlan& plan, std::span<const size_t> rows, const PlyReadOptions& options = {});
+    // Same, but row rows[i] is decoded into output row targets[i] (e.g. targets == rows fills rows in place).
+    void readRows(const detail::ElementReadPlan& plan, std::span<const size_t> rows, std::span<const size_t> targets, const PlyReadOptions& options = {});
 
 private:
+    void readBytes(std::byte* dst, size_t n, const PlyElement& elem);
+    void skipBytes(size_t n, const PlyElement& elem);
+    void skipElement(const detail::ElementReadPlan& plan);
+    bool peekMemory(std::span<const std::byte>& tail);
+    void readFixedRows(const detail::ElementReadPlan& plan, const PlyReadOptions& options);
+    void readVariableRows(const detail::ElementReadPlan& plan, const PlyReadOptions& options);
+    void readAsciiRows(const detail::ElementReadPlan& plan, const PlyReadOptions& options);
+    bool readFixedArityRows(const detail::ElementReadPlan& plan, const PlyReadOptions& options);
+    detail::FixedArity* fixedArity(const PlyElement& elem, const std::byte* data);
+
 	std::istream& _is;
+    std::streamoff _body_offset = -1;
+    std::vector<size_t> _element_offsets;
+    PlyLineIndex _line_index;
+    std::vector<detail::FixedArity> _fixed_arity;
 };
 
 class PlyStreamWriter : public PlyBase {
@@ -137,6 +347,7 @@ public:
     void writeScalar(const PlyScalar& v);
     void writeScalar(const PlyScalar& v, ScalarKind k);
     void writeLineEnd();
+    void writeElement(const detail::ElementWritePlan& plan);
 
     void flush() { _os.flush(); }
 
@@ -148,6 +359,13 @@ private:
 
 PlyFormat detectPlyFormat(const std::filesystem::path& filename);
 
+enum class PlyFileBackend : uint8_t {
+    STREAM,     // reader: buffered with a readahead thread, writer: std::ofstream
+    MAPPING,    // memory-mapped file (TURBOPLY_ENABLE_FILE_MAPPING)
+    IO_URING,   // Linux io_uring, many large block reads or writes in flight
+    DIRECT,     // reader only: aligned O_DIRECT block reads that bypass the page cache
+};
+
 template <class StreamHandler>
     requires std::same_as<StreamHandler, PlyStreamReader> || std::same_as<StreamHandler, PlyStreamWriter>
 class PlyFileHandler : public StreamHandler {
@@ -156,23 +374,38 @@ public:
 
     PlyFileHandler(const std::filesystem::path& filename, bool enable_file_mapping = false)
         requires std::same_as<StreamHandler, PlyStreamReader>
-        : PlyFileHandler{ init(filename, enable_file_mapping, 0), detectPlyFormat(filename) } {
+        : PlyFileHandler{ filename, enable_file_mapping ? PlyFileBackend::MAPPING : PlyFileBackend::STREAM } {
+    }
+    PlyFileHandler(const std::filesystem::path& filename, PlyFileBackend backend)
+        requires std::same_as<StreamHandler, PlyStreamReader>
+        : PlyFileHandler{ init(filename, backend, 0), detectPlyFormat(filename) } {
     }
     PlyFileHandler(const std::filesystem::path& filename, PlyFormat format = PlyFormat::BINARY
         , bool enable_file_mapping = false, size_t reserve_size = 100 * 1024 * 1024) 
         requires std::same_as<StreamHandler, PlyStreamWriter>
-        : PlyFileHandler{ init(filename, enable_file_mapping, reserve_size), format } {
+        : PlyFileHandler{ filename, format, enable_file_mapping ? PlyFileBackend::MAPPING : PlyFileBackend::STREAM, reserve_size } {
+    }
+    PlyFileHandler(const std::filesystem::path& filename, PlyFormat format, PlyFileBackend backend
+        , size_t reserve_size = 100 * 1024 * 1024)
+        requires std::same_as<StreamHandler, PlyStreamWriter>
+        : PlyFileHandler{ init(filename, backend, reserve_size), format } {
+    }
+    virtual ~PlyFileHandler() {
+        try {
+            close();
+        } catch (...) {
+        }
     }
-    virtual ~PlyFileHandler() { close(); }
 
+    // Completes pending I/O and throws if it failed; errors are ignored when closing from the destructor.
     void close();
 
 private:
-    std::unique_ptr<std::streambuf> _mapped_buf;
+    std::unique_ptr<std::streambuf> _file_buf;  // mapping, readahead or io_uring buffer
     std::unique_ptr<StreamT> _managed_stream;
 
     using Resources = std::pair<std::unique_ptr<std::streambuf>, std::unique_ptr<StreamT>>;
-    static Resources init(const std::filesystem::path& filename, bool use_mapping, size_t reserve_size);
+    static Resources init(const std::filesystem::path& filename, PlyFileBackend backend, size_t reserve_size);
 
     PlyFileHandler(Resources&& , PlyFormat );
 };
@@ -180,6 +413,48 @@ private:
 using PlyFileReader = PlyFileHandler<PlyStreamReader>;
 using PlyFileWriter = PlyFileHandler<PlyStreamWriter>;
 
+//////////////////////////////////////////////////////////////////////////
+
+PlyFormat detectPlyFormat(std::span<const std::byte> data);
+
+// Reader over bytes already in memory (message payloads, decompressed buffers, shared memory).
+// Rows are decoded in place through the memory-backed paths; the bytes must outlive the reader.
+class PlyMemoryReader : public PlyStreamReader {
+public:
+    explicit PlyMemoryReader(std::span<const std::byte> data);
+
+private:
+    using Resources = std::pair<std::unique_ptr<std::streambuf>, std::unique_ptr<std::istream>>;
+    static Resources init(std::span<const std::byte> data);
+
+    PlyMemoryReader(Resources&& res, PlyFormat format);
+
+    std::unique_ptr<std::streambuf> _buf;
+    std::unique_ptr<std::istream> _managed_stream;
+};
+
+// Writer into memory: a growable buffer owned by the writer, or a caller-provided buffer whose
+// capacity must not be exceeded. Fixed-stride binary rows are encoded straight into the buffer.
+class PlyMemoryWriter : public PlyStreamWriter {
+public:
+    explicit PlyMemoryWriter(PlyFormat format = PlyFormat::BINARY);
+    explicit PlyMemoryWriter(std::span<std::byte> buffer, PlyFormat format = PlyFormat::BINARY);
+
+    // Bytes written so far.
+    std::span<const std::byte> data() const;
+    // Moves the bytes out of a growable writer, which is left empty.
+    std::vector<std::byte> release();
+
+private:
+    using Resources = std::pair<std::unique_ptr<std::streambuf>, std::unique_ptr<std::ostream>>;
+    static Resources init(std::unique_ptr<std::streambuf> buf);
+
+    PlyMemoryWriter(Resources&& res, PlyFormat format);
+
+    std::unique_ptr<std::streambuf> _buf;
+    std::unique_ptr<std::ostream> _managed_stream;
+};
+
 }
 
 //////////////////////////////////////////////////////////////////////////
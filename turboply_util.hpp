@@ -1,7 +1,16 @@
 #pragma once
 
 #include <span>
+#include <new>
+#include <bit>
+#include <cstring>
+#include <iterator>
 #include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <utility>
 
 namespace turboply {
 
@@ -182,38 +191,50 @@ namespace turboply {
                 static constexpr ScalarKind list_kind = ScalarKind::UINT8;
             };
 
+            template <typename UserT>
+                requires (!std::is_const_v<UserT> && sizeof(UserT) == sizeof(RowT))
+            static std::span<RowT> as_column_view(std::span<UserT> s) {
+                return { reinterpret_cast<RowT*>(s.data()), s.size() };
+            }
+
         public:
             using RowType = RowT;
             using ColumnData = std::vector<RowType>;
             using ColumnView = std::span<RowType>;
+            // 读取时按行数分配输出存储 (对齐内存, 锁页内存, 外部张量等)
+            using ColumnAllocator = std::function<ColumnView(size_t)>;
 
             static constexpr std::string_view element_name{ ElementName };
             static constexpr size_t property_num = sizeof...(PropertyNames);
 
-            PropertySpec(ColumnData& column_data)
-                : _column_view{ column_data }, _column_data{ &column_data } {
-            }
-
-            PropertySpec(const ColumnData& column_data)
-                : _column_view{ const_cast<RowType*>(column_data.data()), column_data.size() }, _column_data{ nullptr } {
-            }
-
             PropertySpec(ColumnView column_view)
-                : _column_view{ column_view }, _column_data{ nullptr } {
+                : _column_view{ column_view } {
             }
 
             PropertySpec(std::span<const RowType> column_view)
-                : _column_view{ const_cast<RowType*>(column_view.data()), column_view.size() }, _column_data{ nullptr } {
+                : _column_view{ const_cast<RowType*>(column_view.data()), column_view.size() } {
             }
 
-            template <typename UserT>
-            PropertySpec(std::vector<UserT>& column_data) requires (sizeof(UserT) == sizeof(RowType))
-                : PropertySpec{ reinterpret_cast<ColumnData&>(column_data) } {
+            // 任意分配器的vector, 读取时resize
+            template <typename UserT, typename Alloc>
+            PropertySpec(std::vector<UserT, Alloc>& column_data) requires (sizeof(UserT) == sizeof(RowType))
+                : _column_view{ as_column_view(std::span<UserT>(column_data)) }
+                , _allocate{ [data = &column_data](size_t n) {
+                    data->resize(n);
+                    return as_column_view(std::span<UserT>(*data));
+                } } {
             }
 
-            template <typename UserT>
-            PropertySpec(const std::vector<UserT>& column_data) requires (sizeof(UserT) == sizeof(RowType))
-                : PropertySpec{ reinterpret_cast<const ColumnData&>(column_data) } {
+            template <typename UserT, typename Alloc>
+            PropertySpec(const std::vector<UserT, Alloc>& column_data) requires (sizeof(UserT) == sizeof(RowType))
+                : PropertySpec{ std::span<const UserT>(column_data) } {
+            }
+
+            // 分配钩子: allocate(n) 返回n行的存储 (std::span<UserT>), 读取时调用一次
+            template <typename AllocateFn>
+                requires std::invocable<AllocateFn&, size_t> && requires(AllocateFn& f) { as_column_view(f(size_t{})); }
+            explicit PropertySpec(AllocateFn allocate)
+                : _allocate{ [allocate = std::move(allocate)](size_t n) mutable { return as_column_view(allocate(n)); } } {
             }
 
             template <typename UserT>
@@ -229,16 +250,23 @@ namespace turboply {
             ColumnView& operator()() { return _column_view; }
             const ColumnView& operator()() const { return _column_view; }
 
-            void resize(size_t n) {
-                if (_column_data) {
-                    _column_data->resize(n);
-                    _column_view = std::span<RowType>(*_column_data);
+            // 返回是否由分配得到了新的存储 (用户提供的span以及原地复用的存储不算)
+            bool resize(size_t n) {
+                if (_allocate) {
+                    const RowType* before = _column_view.data();
+                    _column_view = _allocate(n);
+                    if (_column_view.size() != n)
+                        throw std::runtime_error(std::format(
+                            "Ply Error: Allocation for element '{}' returned {} rows, {} requested."
+                            , element_name, _column_view.size(), n));
+                    return _column_view.data() != before;
                 }
                 else if (_column_view.size() != n) {
                     throw std::runtime_error(std::format(
                         "Ply Error: Element count mismatch. Element '{}' expects {} rows, but provided storage has {} rows."
                         , element_name, n, _column_view.size()));
                 }
+                return false;
             }
 
             template <size_t I>
@@ -273,7 +301,7 @@ namespace turboply {
 
         private:
             ColumnView _column_view;
-            ColumnData* _column_data;
+            ColumnAllocator _allocate;
         };
 
         template <typename T>
@@ -283,6 +311,105 @@ namespace turboply {
             }(t);
         };
 
+        // 列表属性的CSR存储: offsets (行数+1项, 列表长度的前缀和) 与扁平的values, 整列只有两次分配
+        template <detail::fixed_string ElementName, typename T, detail::fixed_string PropertyName>
+        struct CsrListSpec {
+            using ValueType = T;
+
+            static constexpr std::string_view element_name{ ElementName };
+            static constexpr size_t property_num = 1;
+
+            template <size_t I>
+            using ColumnInfo = typename PropertySpec<ElementName, RecordTuple<std::vector<T>>, PropertyName>::template ColumnInfo<I>;
+
+            // 任意分配器的vector, 读取时resize
+            template <typename OffsetAlloc, typename ValueAlloc>
+            CsrListSpec(std::vector<uint64_t, OffsetAlloc>& offsets, std::vector<T, ValueAlloc>& values)
+                : _offsets{ offsets }, _values{ values }
+                , _resize_offsets{ [data = &offsets](size_t n) { data->resize(n); return std::span<uint64_t>(*data); } }
+                , _resize_values{ [data = &values](size_t n) { data->resize(n); return std::span<T>(*data); } } {
+            }
+
+            template <typename OffsetAlloc, typename ValueAlloc>
+            CsrListSpec(const std::vector<uint64_t, OffsetAlloc>& offsets, const std::vector<T, ValueAlloc>& values)
+                : CsrListSpec{ std::span<const uint64_t>(offsets), std::span<const T>(values) } {
+            }
+
+            CsrListSpec(std::span<const uint64_t> offsets, std::span<const T> values)
+                : _offsets{ const_cast<uint64_t*>(offsets.data()), offsets.size() }
+                , _values{ const_cast<T*>(values.data()), values.size() } {
+            }
+
+            std::span<const uint64_t> offsets() const { return _offsets; }
+            std::span<const T> values() const { return _values; }
+            size_t size() const { return _offsets.empty() ? 0 : _offsets.size() - 1; }
+
+            // 读取n行: offsets为n+1项, 值区在解码时分配
+            void resize(size_t n) {
+                if (!_resize_offsets)
+                    throw std::runtime_error(std::format(
+                        "Ply Error: CSR list '{}' of element '{}' is bound to read-only storage."
+                        , ColumnInfo<0>::property_name, element_name));
+
+                _offsets = _resize_offsets(n + 1);
+                _offsets[0] = 0;
+                _values = _resize_values(0);
+                _column = ListColumn{ .offsets = _offsets.data(), .valueSize = sizeof(T), .owner = this, .reserve = &reserve };
+            }
+
+            // 解码之后截去多余的值区
+            void shrink() {
+                _values = _resize_values(static_cast<size_t>(_offsets.back()));
+            }
+
+            ListColumn& column() { return _column; }
+
+            PlyElement create() const {
+                if (!_offsets.empty() && _offsets.back() > _values.size())
+                    throw std::runtime_error(std::format(
+                        "Ply Write Error: CSR list '{}' of element '{}' has offsets up to {}, but only {} values."
+                        , ColumnInfo<0>::property_name, element_name, _offsets.back(), _values.size()));
+
+                PlyElement elem;
+                elem.name = std::string(element_name);
+                elem.count = size();
+                elem.properties.push_back(PlyElement::Property{
+                    .name = std::string(ColumnInfo<0>::property_name),
+                    .valueKind = ColumnInfo<0>::value_kind,
+                    .listKind = ColumnInfo<0>::list_kind
+                });
+
+                return elem;
+            }
+
+        private:
+            // 按顺序追加时倍增, 已统计长度时一次分配到位
+            static void reserve(ListColumn& column, size_t n) {
+                auto& self = *static_cast<CsrListSpec*>(column.owner);
+                if (n <= column.capacity) return;
+
+                self._values = self._resize_values(std::max(n, self._values.size() * 2));
+                column.values = reinterpret_cast<std::byte*>(self._values.data());
+                column.capacity = self._values.size();
+            }
+
+            std::span<uint64_t> _offsets;
+            std::span<T> _values;
+            std::function<std::span<uint64_t>(size_t)> _resize_offsets;
+            std::function<std::span<T>(size_t)> _resize_values;
+            ListColumn _column;
+        };
+
+        template <typename T>
+        concept IsCsrListSpec = requires(T & t) {
+            [] <detail::fixed_string E, typename V, detail::fixed_string P>
+                (const CsrListSpec<E, V, P>&) {
+            }(t);
+        };
+
+        template <typename T>
+        concept IsColumnSpec = IsPropertySpec<T> || IsCsrListSpec<T>;
+
         template <typename T, size_t N>
         using repeat_type_t = typename decltype(
             []<size_t... Is>(std::index_sequence<Is...>) {
@@ -292,6 +419,62 @@ namespace turboply {
 
     }
 
+// Allocator for output columns on aligned storage (cache lines, SIMD loads, DMA).
+template <typename T, size_t Alignment = 64>
+struct AlignedAllocator {
+    static_assert(Alignment >= alignof(T) && std::has_single_bit(Alignment),
+        "AlignedAllocator: Alignment must be a power of two no smaller than alignof(T).");
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ Alignment }));
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        ::operator delete(p, std::align_val_t{ Alignment });
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+};
+
+// Allocator adaptor whose value construction is default-initialization: resize(n) leaves trivial rows
+// uninitialized instead of zero-filling them, for columns the reader overwrites completely.
+template <typename T, typename Base = std::allocator<T>>
+struct DefaultInitAllocator : Base {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = DefaultInitAllocator<U, typename std::allocator_traits<Base>::template rebind_alloc<U>>; };
+
+    using Base::Base;
+    DefaultInitAllocator() = default;
+    template <typename U, typename B>
+    DefaultInitAllocator(const DefaultInitAllocator<U, B>& other) noexcept : Base(static_cast<const B&>(other)) {}
+
+    template <typename U>
+    void construct(U* p) noexcept(std::is_nothrow_default_constructible_v<U>) {
+        ::new (static_cast<void*>(p)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        std::allocator_traits<Base>::construct(static_cast<Base&>(*this), p, std::forward<Args>(args)...);
+    }
+};
+
+// Output column that the reader fills without zero-filling it first.
+template <typename T, typename Base = std::allocator<T>>
+using ColumnVector = std::vector<T, DefaultInitAllocator<T, typename std::allocator_traits<Base>::template rebind_alloc<T>>>;
+
 template <detail::fixed_string ElementName, typename T, detail::fixed_string... PropertyNames>
     requires std::is_arithmetic_v<T>
 using UniformSpec = detail::PropertySpec<ElementName, detail::repeat_type_t<T, sizeof...(PropertyNames)>, PropertyNames...>;
@@ -311,6 +494,12 @@ using NormalSpec = UniformSpec<"vertex", float, "nx", "ny", "nz">;
 using ColorSpec = UniformSpec<"vertex", uint8_t, "red", "green", "blue">;
 using FaceSpec = ListSpec<"face", uint32_t, "vertex_indices", 3>;
 
+// List property read into (and written from) one offsets array and one flat values array: the values of
+// row i are values[offsets[i], offsets[i + 1]). Avoids one allocation per row for long variable lists.
+template <detail::fixed_string ElementName, typename T, detail::fixed_string PropertyName>
+    requires std::is_arithmetic_v<T>
+using CsrListSpec = detail::CsrListSpec<ElementName, T, PropertyName>;
+
 //////////////////////////////////////////////////////////////////////////
 
     namespace detail {
@@ -350,106 +539,880 @@ using FaceSpec = ListSpec<"face", uint32_t, "vertex_indices", 3>;
             }
         }
 
-    }
+        template <typename F>
+        decltype(auto) visit_scalar_kind(ScalarKind k, F&& func) {
+            switch (k) {
+            case ScalarKind::INT8:    return func.template operator()<int8_t>();
+            case ScalarKind::UINT8:   return func.template operator()<uint8_t>();
+            case ScalarKind::INT16:   return func.template operator()<int16_t>();
+            case ScalarKind::UINT16:  return func.template operator()<uint16_t>();
+            case ScalarKind::INT32:   return func.template operator()<int32_t>();
+            case ScalarKind::UINT32:  return func.template operator()<uint32_t>();
+            case ScalarKind::FLOAT32: return func.template operator()<float>();
+            case ScalarKind::FLOAT64: return func.template operator()<double>();
+            }
 
-template <typename... Specs>
-    requires (detail::IsPropertySpec<Specs> && ...)
-void bind_reader(PlyStreamReader& reader, Specs&... specs) {
-    static_assert(!detail::check_property_conflicts<Specs...>(),
-        "Multiple specs bind to the SAME property of the SAME element.");
+            throw std::runtime_error("Ply Error: Unsupported scalar kind.");
+        }
 
-    reader.parseHeader();
+        template <typename T>
+        T load_scalar(const std::byte* p) {
+            T v;
+            std::memcpy(&v, p, sizeof(T));
+            return v;
+        }
 
-    for (const auto& elem : reader.getElements()) {
-        if (elem.count == 0) continue;
+        template <typename S, typename D>
+        void copy_column(const std::byte* src, size_t src_stride, std::byte* dst, size_t dst_stride, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                const D d = static_cast<D>(load_scalar<S>(src + i * src_stride));
+                std::memcpy(dst + i * dst_stride, &d, sizeof(D));
+            }
+        }
 
-        using ColumnReader = std::function<void(size_t)>;
-        std::vector<ColumnReader> columnReaders(elem.properties.size());
+        template <typename Container>
+        void assign_list(std::byte* item, const std::byte* src, size_t n, size_t src_size, ColumnCopyFn copy) {
+            auto& container = *reinterpret_cast<Container*>(item);
+            using D = typename Container::value_type;
 
-        for (size_t pi = 0; pi < elem.properties.size(); ++pi) {
-            auto& prop = elem.properties[pi];
-            columnReaders[pi] = [&reader, prop](size_t) {
-                if (prop.listKind != ScalarKind::UNUSED) {
-                    auto n = ply_cast<uint32_t>(reader.readScalar(prop.listKind));
-                    for (uint32_t k = 0; k < n; ++k) 
-                        reader.readScalar(prop.valueKind);
-                }
-                else {
-                    reader.readScalar(prop.valueKind);
+            if constexpr (requires { container.resize(n); })
+                container.resize(n);
+
+            // 多余的值丢弃; 定长容器 (std::array) 中不足的部分置零, 不留下未初始化的值
+            const size_t limit = std::min(n, container.size());
+            if constexpr (!requires { container.resize(n); })
+                std::fill(std::begin(container) + limit, std::end(container), D{});
+
+            if constexpr (requires { container.data(); }) {
+                copy(src, src_size, reinterpret_cast<std::byte*>(container.data()), sizeof(D), limit);
+            }
+            else {
+                for (size_t k = 0; k < limit; ++k) {
+                    D v;
+                    copy(src + k * src_size, 0, reinterpret_cast<std::byte*>(&v), 0, 1);
+                    container[k] = v;
                 }
-            };
+            }
         }
 
-        ([&](auto& spec) {
-            using SpecT = std::decay_t<decltype(spec)>;
+        template <typename Container>
+        size_t view_list(const std::byte* item, const std::byte*& values) {
+            const auto& container = *reinterpret_cast<const Container*>(item);
+            values = reinterpret_cast<const std::byte*>(std::data(container));
+            return std::size(container);
+        }
 
-            if (SpecT::element_name != elem.name) return;
-            spec.resize(elem.count);
+        // 目标类型对应标准标量类型时使用转换核, 否则逐值static_cast
+        template <typename D>
+        ColumnCopyFn column_copy_fn(ScalarKind k, ScalarKind dk, bool saturate) {
+            if (dk != ScalarKind::UNUSED && sizeof(D) == scalarKindSize(dk))
+                return convertKernel(k, dk, saturate);
+
+            return visit_scalar_kind(k, []<typename S>() -> ColumnCopyFn { return &copy_column<S, D>; });
+        }
+
+        // 属性在元素中的下标, 不存在时抛出
+        inline size_t find_property(const PlyElement& elem, std::string_view name) {
+            auto it = std::find_if(elem.properties.begin(), elem.properties.end(),
+                [&](const auto& prop) { return prop.name == name; });
+
+            if (it == elem.properties.end())
+                throw std::runtime_error(std::format(
+                    "Ply Read Error: Element '{}' is missing required property '{}'."
+                    , elem.name, name));
+
+            return static_cast<size_t>(std::distance(elem.properties.begin(), it));
+        }
+
+        // 把spec的各列绑定到plan中同名的文件属性, 目标行为spec()的第0行; spec没有行时只检查属性, 不设置目标
+        template <typename SpecT>
+        void bind_properties(ElementReadPlan& plan, SpecT& spec, const PlyReadOptions& options) {
+            const auto& elem = *plan.element;
 
             [&] <size_t... Is>(std::index_sequence<Is...>) {
                 ([&]() {
                     using PI = typename SpecT::template ColumnInfo<Is>;
 
-                    auto it = std::find_if(elem.properties.begin(), elem.properties.end(),
-                        [](const auto& prop) { return prop.name == PI::property_name; });
-
-                    if (it != elem.properties.end()) {
-                        size_t pi = std::distance(elem.properties.begin(), it);
-                        const auto& prop = *it; // runtime
-
-                        columnReaders[pi] = [&reader, &spec, prop](size_t row_index) {
-                            auto& row_item = get<Is>(spec()[row_index]);
-
-                            if constexpr (PI::list_kind != ScalarKind::UNUSED) {
-                                if (prop.listKind == ScalarKind::UNUSED)
-                                    throw std::runtime_error(std::format(
-                                        "Ply Read Error: Property '{}' type mismatch. Expected LIST, but found SCALAR in file."
-                                        , PI::property_name));
-                                
-                                auto n = ply_cast<size_t>(reader.readScalar(prop.listKind));
-
-                                [&](auto& container) {
-                                    if constexpr (requires { container.resize(n); })
-                                        container.resize(n);
-
-                                    size_t capacity = 0;
-                                    if constexpr (requires { container.size(); }) 
-                                        capacity = container.size();
-
-                                    size_t limit = std::min(n, capacity); 
-                                    for (size_t k = 0; k < limit; ++k)
-                                        container[k] = ply_cast<typename PI::ScalarType>(reader.readScalar(prop.valueKind));
-                                    for (size_t k = limit; k < n; ++k)
-                                        reader.readScalar(prop.valueKind); // 丢弃
-                                }(row_item);
-                            }
-                            else {
-                                if (prop.listKind != ScalarKind::UNUSED)
-                                    throw std::runtime_error(std::format(
-                                        "Ply Read Error: Property '{}' type mismatch. Expected SCALAR, but found LIST in file."
-                                        , PI::property_name));
+                    const size_t pi = find_property(elem, PI::property_name);
+                    const auto& prop = elem.properties[pi];
+                    auto& binding = plan.bindings[pi];
+                    if constexpr (IsCsrListSpec<SpecT>) {
+                        binding.column = &spec.column();
+                    }
+                    else if (!spec().empty()) {
+                        binding.dst = reinterpret_cast<std::byte*>(&get<Is>(spec()[0]));
+                        binding.dstStride = sizeof(typename SpecT::RowType);
+                    }
 
-                                row_item = ply_cast<typename PI::ScalarType>(reader.readScalar(prop.valueKind));
-                            }
-                        };
+                    if constexpr (PI::list_kind != ScalarKind::UNUSED) {
+                        if (prop.listKind == ScalarKind::UNUSED)
+                            throw std::runtime_error(std::format(
+                                "Ply Read Error: Property '{}' type mismatch. Expected LIST, but found SCALAR in file."
+                                , PI::property_name));
+
+                        binding.dstKind = PI::value_kind;
+                        binding.copy = column_copy_fn<typename PI::ScalarType>(prop.valueKind, PI::value_kind, options.saturate);
+                        if constexpr (!IsCsrListSpec<SpecT>)
+                            binding.assign = &assign_list<typename PI::FieldType>;
+
+                        if constexpr (requires { std::tuple_size<typename PI::FieldType>::value; })
+                            binding.arity = std::tuple_size_v<typename PI::FieldType>;
                     }
                     else {
-                        throw std::runtime_error(std::format(
-                            "Ply Read Error: Element '{}' is missing required property '{}'."
-                            , elem.name, PI::property_name));
+                        if (prop.listKind != ScalarKind::UNUSED)
+                            throw std::runtime_error(std::format(
+                                "Ply Read Error: Property '{}' type mismatch. Expected SCALAR, but found LIST in file."
+                                , PI::property_name));
+
+                        binding.dstKind = PI::value_kind;
+                        binding.copy = column_copy_fn<typename PI::ScalarType>(prop.valueKind, PI::value_kind, options.saturate);
                     }
                 }(), ...);
             }(std::make_index_sequence<SpecT::property_num>{});
-         }(specs), ...); 
+        }
+
+        // 按顺序读取到最后一个被绑定的元素为止, 之后的元素不再读取
+        // select(elem)在被绑定元素的起始处调用: 返回nullptr时流位置不变, 整个元素照常读取;
+        // 返回选中的行号 (已排序) 时只读取这些行, 之后定位到下一个元素; 没有选中的行时spec置空, 不绑定也不解码
+        // prepare(plan)在spec绑定之后, 解码之前调用, 可以调整绑定
+        template <typename Select, typename Prepare, typename... Specs>
+        void read_elements(PlyStreamReader& reader, const PlyReadOptions& options, Select&& select, Prepare&& prepare, Specs&... specs) {
+            reader.parseHeader();
+
+            const auto& elements = reader.getElements();
+            size_t last = 0;
+            for (size_t ei = 0; ei < elements.size(); ++ei) {
+                if (((Specs::element_name == elements[ei].name) || ...))
+                    last = ei + 1;
+            }
+
+            for (size_t ei = 0; ei < last; ++ei) {
+                const auto& elem = elements[ei];
+                if (elem.count == 0) continue;
+
+                const bool bound = ((Specs::element_name == elem.name) || ...);
+                const std::vector<size_t>* rows = bound ? select(elem) : nullptr;
+
+                if (rows && rows->empty()) {
+                    ([&](auto& spec) {
+                        if (std::decay_t<decltype(spec)>::element_name == elem.name) spec.resize(0);
+                    }(specs), ...);
+
+                    if (ei + 1 < last)
+                        reader.seekRow(elements[ei + 1], 0);
+                    continue;
+                }
+
+                ElementReadPlan plan{ elem };
+                std::vector<std::span<std::byte>> columns;
+                ([&](auto& spec) {
+                    using SpecT = std::decay_t<decltype(spec)>;
 
-        for (size_t ri = 0; ri < elem.count; ++ri) {
-            for (auto& rd : columnReaders) rd(ri);
+                    if (SpecT::element_name != elem.name) return;
+                    // 只预先缺页刚分配的存储, 用户提供的存储已驻留
+                    if constexpr (IsPropertySpec<SpecT>) {
+                        if (spec.resize(rows ? rows->size() : elem.count))
+                            columns.push_back(std::as_writable_bytes(spec()));
+                    }
+                    else {
+                        spec.resize(rows ? rows->size() : elem.count);
+                    }
+
+                    bind_properties(plan, spec, options);
+                 }(specs), ...); 
+                prepare(plan);
+
+                // 新分配的列在解码的同时由后台线程缺页
+                PagePrefault prefault{ std::move(columns) };
+
+                if (!rows) {
+                    reader.readElement(plan, options);
+                }
+                else {
+                    reader.readRows(plan, *rows, options);
+                    if (ei + 1 < last)
+                        reader.seekRow(elements[ei + 1], 0);
+                }
+
+                ([&](auto& spec) {
+                    if constexpr (IsCsrListSpec<std::decay_t<decltype(spec)>>) {
+                        if (spec.element_name == elem.name) spec.shrink();
+                    }
+                }(specs), ...);
+            }
+        }
+
+        // 从元素起始处分批解码键列, 每批之后select(first, n, selected)追加通过的行号
+        // bind(plan)把键列绑定到该批 (plan.element->count行) 的缓冲
+        template <typename Bind, typename F>
+        std::vector<size_t> select_rows(PlyStreamReader& reader, const PlyElement& elem, const PlyReadOptions& options, Bind&& bind, F&& select) {
+            constexpr size_t BATCH_ROWS = 64 * 1024;
+
+            std::vector<size_t> selected;
+            PlyElement part = elem;
+
+            for (size_t first = 0; first < elem.count; first += BATCH_ROWS) {
+                part.count = std::min(BATCH_ROWS, elem.count - first);
+
+                ElementReadPlan plan{ part };
+                bind(plan);
+                reader.readElement(plan, options);
+
+                select(first, part.count, selected);
+            }
+
+            return selected;
+        }
+
+        // 按名字把标量属性绑定到float列 (批缓冲, 按该批的行数重设)
+        inline void bind_float_column(ElementReadPlan& plan, std::string_view name, ColumnVector<float>& column, const PlyReadOptions& options) {
+            const size_t pi = find_property(*plan.element, name);
+            const auto& prop = plan.element->properties[pi];
+            if (prop.listKind != ScalarKind::UNUSED)
+                throw std::runtime_error(std::format(
+                    "Ply Read Error: Property '{}' type mismatch. Expected SCALAR, but found LIST in file.", name));
+
+            column.resize(plan.element->count);
+            plan.bindings[pi] = PropertyBinding{
+                .dst = reinterpret_cast<std::byte*>(column.data()), .dstStride = sizeof(float), .dstKind = ScalarKind::FLOAT32,
+                .copy = column_copy_fn<float>(prop.valueKind, ScalarKind::FLOAT32, options.saturate) };
+        }
+
+        // 列表属性按文件中的类型原样读入CSR (批缓冲), 值不做转换
+        struct RawListColumn {
+            ColumnVector<uint64_t> offsets;
+            ColumnVector<std::byte> values;
+            ListColumn column;
+
+            void bind(ElementReadPlan& plan, size_t pi) {
+                const auto& prop = plan.element->properties[pi];
+                const size_t vsize = scalarKindSize(prop.valueKind);
+
+                offsets.resize(plan.element->count + 1);
+                offsets[0] = 0;
+                column = ListColumn{ .offsets = offsets.data(), .values = values.data(), .capacity = values.size() / vsize
+                    , .valueSize = vsize, .owner = this, .reserve = &reserve };
+                plan.bindings[pi] = PropertyBinding{ .dstKind = prop.valueKind, .copy = convertKernel(prop.valueKind, prop.valueKind), .column = &column };
+            }
+
+            static void reserve(ListColumn& column, size_t n) {
+                auto& self = *static_cast<RawListColumn*>(column.owner);
+                if (n <= column.capacity) return;
+
+                self.values.resize(std::max(n, column.capacity * 2) * column.valueSize);
+                column.values = self.values.data();
+                column.capacity = self.values.size() / column.valueSize;
+            }
+        };
+
+        // box.faceElement的box.indexProperty列表映射为顶点在kept (已排序, 包含全部被引用的顶点) 中的位置
+        template <typename SpecT>
+        void remap_vertex_indices(SpecT& spec, const PlyBox& box, std::span<const size_t> kept) {
+            if (SpecT::element_name != box.faceElement) return;
+
+            [&] <size_t... Is>(std::index_sequence<Is...>) {
+                ([&]() {
+                    using PI = typename SpecT::template ColumnInfo<Is>;
+
+                    if constexpr (PI::list_kind != ScalarKind::UNUSED) {
+                        if (PI::property_name != box.indexProperty) return;
+
+                        for (auto& row : spec()) {
+                            for (auto& v : get<Is>(row)) {
+                                const auto it = std::lower_bound(kept.begin(), kept.end(), static_cast<size_t>(v));
+                                v = static_cast<typename PI::ScalarType>(it - kept.begin());
+                            }
+                        }
+                    }
+                }(), ...);
+            }(std::make_index_sequence<SpecT::property_num>{});
         }
+
     }
+
+template <typename... Specs>
+    requires (detail::IsColumnSpec<Specs> && ...)
+void bind_reader(PlyStreamReader& reader, const PlyReadOptions& options, Specs&... specs) {
+    static_assert(!detail::check_property_conflicts<Specs...>(),
+        "Multiple specs bind to the SAME property of the SAME element.");
+
+    // 抽样的元素只解码选中的行
+    const auto& sampling = options.sampling;
+    std::vector<size_t> sampled;
+
+    detail::read_elements(reader, options, [&](const PlyElement& elem) -> const std::vector<size_t>* {
+        if (!sampling.enabled() || !(sampling.element.empty() || sampling.element == elem.name))
+            return nullptr;
+
+        sampled = sampling.sampleRows(elem.count);
+        return &sampled;
+    }, [](detail::ElementReadPlan&) {}, specs...);
 }
 
+template <typename... Specs>
+    requires (detail::IsColumnSpec<Specs> && ...)
+void bind_reader(PlyStreamReader& reader, Specs&... specs) {
+    bind_reader(reader, PlyReadOptions{}, specs...);
+}
+
+// Loads only the vertices inside the box: the coordinates are decoded first in batches and tested, and the
+// bound vertex specs then receive the passing rows only. Bound face specs keep the faces whose vertices all
+// passed, with the index lists remapped to the compacted vertices; the index lists are decoded once, by the
+// face test. Element and property names are taken from box. The reader must be memory-backed or seekable.
 template <typename... Specs>
     requires (detail::IsPropertySpec<Specs> && ...)
+void bind_box_reader(PlyStreamReader& reader, const PlyBox& box, const PlyReadOptions& options, Specs&... specs) {
+    static_assert(!detail::check_property_conflicts<Specs...>(),
+        "Multiple specs bind to the SAME property of the SAME element.");
+
+    reader.parseHeader();
+
+    const auto& elements = reader.getElements();
+    auto vertex = std::find_if(elements.begin(), elements.end(), [&](const auto& e) { return e.name == box.vertexElement; });
+
+    std::vector<size_t> kept, faces;
+    bool selected = false;
+
+    auto selectVertices = [&](const PlyElement& elem) {
+        std::array<ColumnVector<float>, 3> xyz;
+
+        kept = detail::select_rows(reader, elem, options, [&](detail::ElementReadPlan& plan) {
+            for (size_t a = 0; a < 3; ++a)
+                detail::bind_float_column(plan, box.coordinates[a], xyz[a], options);
+        }, [&](size_t first, size_t n, std::vector<size_t>& rows) {
+            box.select(xyz[0].data(), xyz[1].data(), xyz[2].data(), n, first, rows);
+        });
+        selected = true;
+    };
+
+    // 通过的面的索引列表按文件中的类型保留 (CSR), 绑定了索引的spec由此写入, 不再解码第二次
+    size_t index_pi = 0, index_size = 0;
+    std::vector<uint64_t> index_offsets{ 0 };
+    std::vector<std::byte> index_values;
+    detail::PropertyBinding index_binding;
+
+    detail::read_elements(reader, options, [&](const PlyElement& elem) -> const std::vector<size_t>* {
+        if (elem.name == box.vertexElement) {
+            if (!selected) selectVertices(elem);
+            return &kept;
+        }
+        if (elem.name != box.faceElement) return nullptr;
+
+        index_pi = detail::find_property(elem, box.indexProperty);
+        const auto& prop = elem.properties[index_pi];
+        if (prop.listKind == ScalarKind::UNUSED)
+            throw std::runtime_error(std::format(
+                "Ply Read Error: Property '{}' type mismatch. Expected LIST, but found SCALAR in file.", prop.name));
+        index_size = scalarKindSize(prop.valueKind);
+
+        // 顶点未被绑定或位于面之后时先单独筛选顶点
+        if (!selected && vertex != elements.end()) {
+            reader.seekRow(*vertex, 0);
+            selectVertices(*vertex);
+            reader.seekRow(elem, 0);
+        }
+
+        // 没有顶点在盒子内时没有面通过, 不必解码索引
+        faces.clear();
+        if (kept.empty()) return &faces;
+
+        detail::RawListColumn indices;
+        faces = detail::select_rows(reader, elem, options, [&](detail::ElementReadPlan& plan) {
+            indices.bind(plan, index_pi);
+        }, [&](size_t first, size_t n, std::vector<size_t>& rows) {
+            for (size_t i = 0; i < n; ++i) {
+                const size_t count = static_cast<size_t>(indices.offsets[i + 1] - indices.offsets[i]);
+                const std::byte* src = indices.values.data() + indices.offsets[i] * index_size;
+
+                const bool inside = detail::visit_scalar_kind(prop.valueKind, [&]<typename T>() {
+                    for (size_t k = 0; k < count; ++k) {
+                        const T v = detail::load_scalar<T>(src + k * index_size);
+                        if (!(v >= T{}) || !std::binary_search(kept.begin(), kept.end(), static_cast<size_t>(v)))
+                            return false;
+                    }
+                    return true;
+                });
+                if (!inside) continue;
+
+                rows.push_back(first + i);
+                index_offsets.push_back(index_offsets.back() + count);
+                index_values.insert(index_values.end(), src, src + count * index_size);
+            }
+        });
+        return &faces;
+    }, [&](detail::ElementReadPlan& plan) {
+        // 面的spec对索引的绑定移出解码计划, 之后由保留的列表写入
+        if (plan.element->name == box.faceElement)
+            index_binding = std::exchange(plan.bindings[index_pi], detail::PropertyBinding{});
+    }, specs...);
+
+    if (index_binding.assign && !faces.empty()) {
+        for (size_t k = 0; k < faces.size(); ++k) {
+            index_binding.assign(index_binding.dst + k * index_binding.dstStride, index_values.data() + index_offsets[k] * index_size
+                , static_cast<size_t>(index_offsets[k + 1] - index_offsets[k]), index_size, index_binding.copy);
+        }
+    }
+
+    // 没有保留的顶点时也没有面, 无需重映射
+    if (!kept.empty())
+        (detail::remap_vertex_indices(specs, box, kept), ...);
+}
+
+// Loads only the rows of KeySpec's element for which pred(key_row) holds. The key columns are decoded
+// first in batches, then the bound specs of that element receive the passing rows only, in file order;
+// rejected rows are never decoded beyond their keys. The reader must be memory-backed or seekable.
+template <typename KeySpec, typename Pred, typename... Specs>
+    requires detail::IsPropertySpec<KeySpec> && std::predicate<Pred&, const typename KeySpec::RowType&>
+        && (detail::IsPropertySpec<Specs> && ...)
+void bind_filtered_reader(PlyStreamReader& reader, Pred&& pred, const PlyReadOptions& options, Specs&... specs) {
+    static_assert(!detail::check_property_conflicts<Specs...>(),
+        "Multiple specs bind to the SAME property of the SAME element.");
+
+    std::vector<size_t> passed;
+
+    detail::read_elements(reader, options, [&](const PlyElement& elem) -> const std::vector<size_t>* {
+        if (elem.name != KeySpec::element_name) return nullptr;
+
+        ColumnVector<typename KeySpec::RowType> keys;
+        KeySpec key{ keys };
+
+        passed = detail::select_rows(reader, elem, options, [&](detail::ElementReadPlan& plan) {
+            key.resize(plan.element->count);
+            detail::bind_properties(plan, key, options);
+        }, [&](size_t first, size_t n, std::vector<size_t>& rows) {
+            for (size_t i = 0; i < n; ++i) {
+                const auto& row = keys[i];
+                if (pred(row))
+                    rows.push_back(first + i);
+            }
+        });
+        return &passed;
+    }, [](detail::ElementReadPlan&) {}, specs...);
+}
+
+// Decodes rows [first, first + count) of the spec's element, resizing the spec to count rows.
+template <typename Spec>
+    requires detail::IsPropertySpec<Spec>
+void read_rows(PlyStreamReader& reader, Spec& spec, size_t first, size_t count, const PlyReadOptions& options = {}) {
+    const auto& elements = reader.getElements();
+    auto elem = std::find_if(elements.begin(), elements.end(),
+        [](const auto& e) { return e.name == Spec::element_name; });
+
+    if (elem == elements.end())
+        throw std::runtime_error(std::format("Ply Read Error: Element '{}' not found.", Spec::element_name));
+    if (first > elem->count || count > elem->count - first)
+        throw std::runtime_error(std::format(
+            "Ply Read Error: Rows [{}, {}) are out of range for element '{}' with {} rows."
+            , first, first + count, elem->name, elem->count));
+
+    spec.resize(count);
+    if (count == 0) return;
+
+    reader.seekRow(*elem, first);
+
+    PlyElement part = *elem;
+    part.count = count;
+
+    detail::ElementReadPlan plan{ part };
+    detail::bind_properties(plan, spec, options);
+    reader.readElement(plan, options);
+}
+
+// Gathers the listed rows (any order, duplicates allowed) of the spec's element, resizing the spec to
+// rows.size(). Output row i holds row rows[i].
+template <typename Spec>
+    requires detail::IsPropertySpec<Spec>
+void read_rows(PlyStreamReader& reader, Spec& spec, std::span<const size_t> rows, const PlyReadOptions& options = {}) {
+    const auto& elements = reader.getElements();
+    auto elem = std::find_if(elements.begin(), elements.end(),
+        [](const auto& e) { return e.name == Spec::element_name; });
+
+    if (elem == elements.end())
+        throw std::runtime_error(std::format("Ply Read Error: Element '{}' not found.", Spec::element_name));
+
+    spec.resize(rows.size());
+    if (rows.empty()) return;
+
+    detail::ElementReadPlan plan{ *elem };
+    detail::bind_properties(plan, spec, options);
+    reader.readRows(plan, rows, options);
+}
+
+// Loads the spec's element in passes of decreasing stride (see PlyProgressiveOptions), resizing the spec to
+// the full row count up front. After each pass on_pass(stride) is called: rows r with r % stride == 0 are
+// then valid, so a viewer can draw a coarse subset long before the whole element is decoded.
+template <typename Spec, typename F>
+    requires detail::IsPropertySpec<Spec> && std::invocable<F&, size_t>
+void bind_progressive_reader(PlyStreamReader& reader, Spec& spec, const PlyProgressiveOptions& progressive, F&& on_pass, const PlyReadOptions& options = {}) {
+    constexpr size_t MAX_CALL_ROWS = 1024 * 1024;
+
+    const auto& elements = reader.getElements();
+    auto elem = std::find_if(elements.begin(), elements.end(),
+        [](const auto& e) { return e.name == Spec::element_name; });
+
+    if (elem == elements.end())
+        throw std::runtime_error(std::format("Ply Read Error: Element '{}' not found.", Spec::element_name));
+
+    spec.resize(elem->count);
+    if (elem->count == 0) return;
+
+    detail::ElementReadPlan plan{ *elem };
+    detail::bind_properties(plan, spec, options);
+
+    // 每轮的间隔整除上一轮, 上一轮间隔的倍数都已读取
+    const size_t factor = std::max<size_t>(progressive.factor, 2);
+    size_t prev = 0;
+    std::vector<size_t> rows;
+
+    for (size_t stride = std::max<size_t>(progressive.coarseStride, 1);; stride = stride % factor ? 1 : stride / factor) {
+        // 行号表分段生成, 每段原位解码
+        for (size_t r = 0; r < elem->count;) {
+            rows.clear();
+            for (; r < elem->count && rows.size() < MAX_CALL_ROWS; r += stride) {
+                if (!prev || r % prev) rows.push_back(r);
+            }
+            reader.readRows(plan, rows, rows, options);
+        }
+
+        on_pass(stride);
+        if (stride == 1) break;
+        prev = stride;
+    }
+}
+
+// Streams the element of Spec in batches of rows instead of materializing whole columns. Each batch is
+// decoded into a reused buffer and passed to on_batch(first_row, rows). With workers > 0 the batches are
+// consumed concurrently and in no particular order; reading blocks while every buffer is in use.
+template <typename Spec, typename F>
+    requires detail::IsPropertySpec<Spec> && std::invocable<F&, size_t, std::span<typename Spec::RowType>>
+void bind_batch_reader(PlyStreamReader& reader, const PlyBatchOptions& batch, F&& on_batch, const PlyReadOptions& options = {}) {
+    using RowType = typename Spec::RowType;
+
+    const auto& elements = reader.getElements();
+    auto elem = std::find_if(elements.begin(), elements.end(),
+        [](const auto& e) { return e.name == Spec::element_name; });
+    if (elem == elements.end() || elem->count == 0) return;
+
+    for (auto it = elements.begin(); it != elem; ++it)
+        reader.readElement(detail::ElementReadPlan{ *it }, options);
+
+    const size_t buffers = batch.workers ? size_t{ batch.workers } * 2 : 1;
+    size_t batch_rows = std::max<size_t>(1, batch.batchRows);
+    if (batch.memoryLimit)
+        batch_rows = std::clamp<size_t>(batch.memoryLimit / (buffers * sizeof(RowType)), 1, batch_rows);
+    batch_rows = std::min(batch_rows, elem->count);
+
+    std::vector<ColumnVector<RowType>> pool(buffers);
+    PlyElement part = *elem;
+
+    auto decode = [&](size_t bi, size_t first) {
+        part.count = std::min(batch_rows, elem->count - first);
+        pool[bi].resize(batch_rows);
+
+        Spec spec{ pool[bi] };
+        detail::ElementReadPlan plan{ part };
+        detail::bind_properties(plan, spec, options);
+        reader.readElement(plan, options);
+
+        return std::span<RowType>(pool[bi].data(), part.count);
+    };
+
+    if (!batch.workers) {
+        for (size_t first = 0; first < elem->count; first += batch_rows)
+            on_batch(first, decode(0, first));
+        return;
+    }
+
+    // 空闲缓冲用尽时读取阻塞, 消费者归还缓冲后继续
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<size_t> free_buffers(buffers);
+    std::deque<std::pair<size_t, size_t>> ready;
+    std::exception_ptr error;
+    bool done = false;
+
+    for (size_t bi = 0; bi < buffers; ++bi) free_buffers[bi] = bi;
+
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned w = 0; w < batch.workers; ++w) {
+            threads.emplace_back([&]() {
+                for (;;) {
+                    std::unique_lock lock(mutex);
+                    cv.wait(lock, [&]() { return !ready.empty() || done; });
+                    if (ready.empty()) return;
+
+                    const auto [bi, first] = ready.front();
+                    ready.pop_front();
+                    lock.unlock();
+
+                    try {
+                        const size_t n = std::min(batch_rows, elem->count - first);
+                        on_batch(first, std::span<RowType>(pool[bi].data(), n));
+                    }
+                    catch (...) {
+                        std::lock_guard guard(mutex);
+                        if (!error) error = std::current_exception();
+                    }
+
+                    lock.lock();
+                    free_buffers.push_back(bi);
+                    cv.notify_all();
+                }
+            });
+        }
+
+        try {
+            for (size_t first = 0; first < elem->count; first += batch_rows) {
+                size_t bi;
+                {
+                    std::unique_lock lock(mutex);
+                    cv.wait(lock, [&]() { return !free_buffers.empty() || error; });
+                    if (error) break;
+
+                    bi = free_buffers.back();
+                    free_buffers.pop_back();
+                }
+
+                decode(bi, first);
+
+                std::lock_guard guard(mutex);
+                ready.emplace_back(bi, first);
+                cv.notify_all();
+            }
+        }
+        catch (...) {
+            std::lock_guard guard(mutex);
+            if (!error) error = std::current_exception();
+        }
+
+        {
+            std::lock_guard guard(mutex);
+            done = true;
+        }
+        cv.notify_all();
+    }
+
+    if (error) std::rethrow_exception(error);
+}
+
+namespace detail {
+
+    // 检查元素的文件行与Spec::RowType逐字节一致, 返回元素在内存中的字节
+    template <typename Spec>
+    std::span<const std::byte> view_memory(PlyStreamReader& reader) {
+        using RowType = typename Spec::RowType;
+
+        const auto& elements = reader.getElements();
+        auto elem = std::find_if(elements.begin(), elements.end(),
+            [](const auto& e) { return e.name == Spec::element_name; });
+
+        if (elem == elements.end())
+            throw std::runtime_error(std::format("Ply Read Error: Element '{}' not found.", Spec::element_name));
+
+        if (elem->properties.size() != Spec::property_num)
+            throw std::runtime_error(std::format(
+                "Ply Read Error: View of element '{}' must bind all {} properties in file order."
+                , elem->name, elem->properties.size()));
+
+        detail::ElementReadPlan plan{ *elem };
+        const RowType row{};
+
+        [&] <size_t... Is>(std::index_sequence<Is...>) {
+            ([&]() {
+                using PI = typename Spec::template ColumnInfo<Is>;
+                const auto& prop = elem->properties[Is];
+                const size_t offset = reinterpret_cast<const std::byte*>(&get<Is>(row)) - reinterpret_cast<const std::byte*>(&row);
+
+                if (prop.name != PI::property_name || prop.listKind != ScalarKind::UNUSED
+                    || prop.valueKind != PI::value_kind || plan.offsets[Is] != offset)
+                    throw std::runtime_error(std::format(
+                        "Ply Read Error: Property '{}' of element '{}' does not match the file layout for a zero-copy view."
+                        , PI::property_name, elem->name));
+            }(), ...);
+        }(std::make_index_sequence<Spec::property_num>{});
+
+        if (plan.stride != sizeof(RowType))
+            throw std::runtime_error(std::format(
+                "Ply Read Error: Row size of element '{}' ({} bytes) does not match the view type ({} bytes)."
+                , elem->name, plan.stride, sizeof(RowType)));
+
+        return reader.elementMemory(*elem);
+    }
+
+}
+
+// Zero-copy view of a binary element inside a memory-backed reader. The spec must bind every property
+// of the element in file order with the file's scalar types, so that RowType matches the file row byte
+// for byte. The view stays valid for the lifetime of the reader.
+// The element must also start at an address aligned for UserT. Element data follows a text header of
+// arbitrary length, so this is often NOT the case for types wider than one byte and the call throws;
+// use the overload taking fallback storage, or bind_column_view, when the file is not known to be aligned.
+template <typename Spec, typename UserT = typename Spec::RowType>
+    requires detail::IsPropertySpec<Spec> && (sizeof(UserT) == sizeof(typename Spec::RowType))
+std::span<const UserT> bind_view(PlyStreamReader& reader) {
+    const auto memory = detail::view_memory<Spec>(reader);
+    if (reinterpret_cast<std::uintptr_t>(memory.data()) % alignof(UserT) != 0)
+        throw std::runtime_error(std::format(
+            "Ply Read Error: Data of element '{}' is not aligned for a zero-copy view.", Spec::element_name));
+
+    return { reinterpret_cast<const UserT*>(memory.data()), memory.size() / sizeof(UserT) };
+}
+
+// Same as above, but when the element is not aligned for UserT its rows are copied into fallback (one
+// memcpy) and the returned span refers to fallback instead. Aligned data is still viewed in place.
+template <typename Spec, typename UserT, typename Alloc>
+    requires detail::IsPropertySpec<Spec> && (sizeof(UserT) == sizeof(typename Spec::RowType)) && std::is_trivially_copyable_v<UserT>
+std::span<const UserT> bind_view(PlyStreamReader& reader, std::vector<UserT, Alloc>& fallback) {
+    const auto memory = detail::view_memory<Spec>(reader);
+    if (reinterpret_cast<std::uintptr_t>(memory.data()) % alignof(UserT) == 0)
+        return { reinterpret_cast<const UserT*>(memory.data()), memory.size() / sizeof(UserT) };
+
+    fallback.resize(memory.size() / sizeof(UserT));
+    std::memcpy(fallback.data(), memory.data(), memory.size());
+    return fallback;
+}
+
+// Lazy random-access view of N scalar properties addressed in place at base + row * stride + offset.
+// Values are loaded on access and converted to T when the file stores a different scalar type.
+template <typename T, size_t N = 1>
+    requires std::is_arithmetic_v<T> && (N > 0)
+class StridedColumnView {
+public:
+    using value_type = std::conditional_t<N == 1, T, std::array<T, N>>;
+
+    class iterator {
+    public:
+        // 解引用返回值而非引用: 对C++20的range是随机访问迭代器, 对旧式算法只是输入迭代器
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = StridedColumnView::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+
+        iterator() = default;
+        iterator(const StridedColumnView* view, size_t row) : _view{ view }, _row{ row } {}
+
+        value_type operator*() const { return (*_view)[_row]; }
+        value_type operator[](difference_type n) const { return (*_view)[_row + n]; }
+
+        iterator& operator++() { ++_row; return *this; }
+        iterator operator++(int) { auto t = *this; ++_row; return t; }
+        iterator& operator--() { --_row; return *this; }
+        iterator operator--(int) { auto t = *this; --_row; return t; }
+        iterator& operator+=(difference_type n) { _row += n; return *this; }
+        iterator& operator-=(difference_type n) { _row -= n; return *this; }
+
+        friend iterator operator+(iterator it, difference_type n) { return it += n; }
+        friend iterator operator+(difference_type n, iterator it) { return it += n; }
+        friend iterator operator-(iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const iterator& a, const iterator& b) {
+            return static_cast<difference_type>(a._row) - static_cast<difference_type>(b._row);
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a._row == b._row; }
+        friend auto operator<=>(const iterator& a, const iterator& b) { return a._row <=> b._row; }
+
+    private:
+        const StridedColumnView* _view = nullptr;
+        size_t _row = 0;
+    };
+
+    StridedColumnView() = default;
+
+    StridedColumnView(const std::byte* base, size_t count, size_t stride,
+        const std::array<size_t, N>& offsets, const std::array<ScalarKind, N>& kinds)
+        : _base{ base }, _count{ count }, _stride{ stride }, _offsets{ offsets } {
+
+        for (size_t k = 0; k < N; ++k)
+            _loads[k] = detail::visit_scalar_kind(kinds[k], []<typename S>() -> LoadFn { return &load<S>; });
+    }
+
+    size_t size() const { return _count; }
+    bool empty() const { return _count == 0; }
+
+    T get(size_t row, size_t k) const {
+        return _loads[k](_base + row * _stride + _offsets[k]);
+    }
+
+    value_type operator[](size_t row) const {
+        if constexpr (N == 1) {
+            return get(row, 0);
+        }
+        else {
+            value_type v;
+            for (size_t k = 0; k < N; ++k) v[k] = get(row, k);
+            return v;
+        }
+    }
+
+    iterator begin() const { return { this, 0 }; }
+    iterator end() const { return { this, _count }; }
+
+private:
+    using LoadFn = T(*)(const std::byte*);
+
+    template <typename S>
+    static T load(const std::byte* p) { return static_cast<T>(detail::load_scalar<S>(p)); }
+
+    const std::byte* _base = nullptr;
+    size_t _count = 0;
+    size_t _stride = 0;
+    std::array<size_t, N> _offsets{};
+    std::array<LoadFn, N> _loads{};
+};
+
+// Strided view of the properties bound by a uniform spec, located anywhere inside the rows of a
+// fixed-stride binary element of a memory-backed reader. Nothing is decoded until accessed.
+template <typename Spec>
+    requires detail::IsPropertySpec<Spec>
+auto bind_column_view(PlyStreamReader& reader) {
+    using T = typename Spec::template ColumnInfo<0>::FieldType;
+    constexpr size_t N = Spec::property_num;
+
+    static_assert(std::is_arithmetic_v<T> &&
+        []<size_t... Is>(std::index_sequence<Is...>) {
+            return (std::is_same_v<typename Spec::template ColumnInfo<Is>::FieldType, T> && ...);
+        }(std::make_index_sequence<N>{}),
+        "bind_column_view: all properties of the spec must share one scalar type.");
+
+    const auto& elements = reader.getElements();
+    auto elem = std::find_if(elements.begin(), elements.end(),
+        [](const auto& e) { return e.name == Spec::element_name; });
+
+    if (elem == elements.end())
+        throw std::runtime_error(std::format("Ply Read Error: Element '{}' not found.", Spec::element_name));
+
+    detail::ElementReadPlan plan{ *elem };
+    if (!plan.stride)
+        throw std::runtime_error(std::format(
+            "Ply Read Error: Element '{}' has list properties and no fixed row stride.", elem->name));
+
+    std::array<size_t, N> offsets;
+    std::array<ScalarKind, N> kinds;
+
+    [&] <size_t... Is>(std::index_sequence<Is...>) {
+        ([&]() {
+            using PI = typename Spec::template ColumnInfo<Is>;
+
+            auto it = std::find_if(elem->properties.begin(), elem->properties.end(),
+                [](const auto& prop) { return prop.name == PI::property_name; });
+
+            if (it == elem->properties.end())
+                throw std::runtime_error(std::format(
+                    "Ply Read Error: Element '{}' is missing required property '{}'."
+                    , elem->name, PI::property_name));
+
+            offsets[Is] = plan.offsets[std::distance(elem->properties.begin(), it)];
+            kinds[Is] = it->valueKind;
+        }(), ...);
+    }(std::make_index_sequence<N>{});
+
+    return StridedColumnView<T, N>{ reader.elementMemory(*elem).data(), elem->count, plan.stride, offsets, kinds };
+}
+
+template <typename... Specs>
+    requires (detail::IsColumnSpec<Specs> && ...)
 void bind_writer(PlyStreamWriter& writer, const Specs&... specs) {
     static_assert(!detail::check_property_conflicts<Specs...>(),
         "Multiple specs bind to the SAME property of the SAME element.");
@@ -483,39 +1446,47 @@ void bind_writer(PlyStreamWriter& writer, const Specs&... specs) {
     writer.writeHeader();
 
     for (const auto& elem : unique_elements) {
-        for (size_t ri = 0; ri < elem.count; ++ri) {
+        detail::ElementWritePlan plan{ elem };
+        size_t pi = 0; // 属性按spec顺序合并, 与create()一致
+        // 文件属性的类型即spec的类型, 各列不设copy, 按字节拷贝
 
-            ([&]() {
-                using SpecT = std::decay_t<decltype(specs)>;
-                if (SpecT::element_name == elem.name) {
-                    const auto& row_view = specs()[ri];
-
-                    [&] <size_t... Is>(std::index_sequence<Is...>) {
-                        ([&]() {
-                            using PI = typename SpecT::template ColumnInfo<Is>;
-                            const auto& row_item = get<Is>(row_view);
-
-                            if constexpr (PI::list_kind != ScalarKind::UNUSED) {
-                                [&](auto& container) {
-                                    size_t c_size = 0;
-                                    if constexpr (requires { container.size(); })
-                                        c_size = container.size(); 
-
-                                    writer.writeScalar(static_cast<uint32_t>(c_size), PI::list_kind);
-                                    for (const auto& v : container) 
-                                        writer.writeScalar(v/*, PI::value_kind*/);
-                                }(row_item);
-                            }
-                            else {
-                                writer.writeScalar(row_item/*, PI::value_kind*/);
-                            }
-                        }(), ...);
-                    }(std::make_index_sequence<SpecT::property_num>{});
-                }
-            }(), ...);
+        ([&](const auto& spec) {
+            using SpecT = std::decay_t<decltype(spec)>;
 
-            writer.writeLineEnd();
-        }
+            if (SpecT::element_name != elem.name) return;
+
+            if constexpr (detail::IsCsrListSpec<SpecT>) {
+                static constexpr uint64_t no_rows[1] = {};
+
+                auto& source = plan.sources[pi];
+                source.src = reinterpret_cast<const std::byte*>(spec.values().data());
+                source.offsets = spec.offsets().empty() ? no_rows : spec.offsets().data();
+                source.valueSize = sizeof(typename SpecT::ValueType);
+
+                ++pi;
+            }
+            else {
+                [&] <size_t... Is>(std::index_sequence<Is...>) {
+                    ([&]() {
+                        using PI = typename SpecT::template ColumnInfo<Is>;
+                        static_assert(PI::value_kind != ScalarKind::UNUSED, "bind_writer: Unsupported field scalar type.");
+
+                        auto& source = plan.sources[pi];
+                        if (elem.count)
+                            source.src = reinterpret_cast<const std::byte*>(&get<Is>(spec()[0]));
+                        source.srcStride = sizeof(typename SpecT::RowType);
+                        source.valueSize = sizeof(typename PI::ScalarType);
+
+                        if constexpr (PI::list_kind != ScalarKind::UNUSED)
+                            source.view = &detail::view_list<typename PI::FieldType>;
+
+                        ++pi;
+                    }(), ...);
+                }(std::make_index_sequence<SpecT::property_num>{});
+            }
+        }(specs), ...);
+
+        writer.writeElement(plan);
     }
 
     writer.flush();